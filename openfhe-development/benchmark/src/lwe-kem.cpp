@@ -0,0 +1,387 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ * Benchmarks for the LWE and Module-LWE KEM of src/LWE-KEM.cpp: KeyGen, Encaps and Decaps, and the stages they are
+ * made of (sampling, matrix-vector product, hashing, serialization). The LWE benchmarks take the arguments
+ * n (= m), q, 10 * sigma and eta (the bound of the binomial secret); the Module-LWE ones take the rank k.
+ *
+ * Besides the time per operation, every benchmark reports items_per_second (operations per second); the
+ * single-threaded runs also report bytes_alloc, the bytes requested from operator new per operation by all
+ * threads, OpenMP workers included.
+ */
+
+#include "benchmark/benchmark.h"
+#include "LWE-KEM.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace lbcrypto;
+
+/*
+ * Allocation accounting
+ */
+
+// shared by every thread, so that allocations made by OpenMP workers are counted as well
+static std::atomic<uint64_t> allocatedBytes{0};
+
+// The replacement functions are kept out of line: once inlined into a caller, GCC pairs the free() below with
+// the builtin operator new and reports -Wmismatched-new-delete
+__attribute__((noinline)) void* operator new(size_t size) {
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void* operator new(size_t size, std::align_val_t alignment) {
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+    if (void* p = std::aligned_alloc(align, (size + align - 1) / align * align))
+        return p;
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+__attribute__((noinline)) void* operator new[](size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p, size_t) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+__attribute__((noinline)) void operator delete[](void* p, size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+// sets items_per_second and bytes_alloc from the bytes allocated since start. The counter is global, so with
+// several benchmark threads it would also see their setup; bytes_alloc is reported by single-threaded runs only
+static void ReportCounters(benchmark::State& state, uint64_t start) {
+    state.SetItemsProcessed(state.iterations());
+    if (state.threads == 1) {
+        state.counters["bytes_alloc"] =
+            benchmark::Counter(static_cast<double>(allocatedBytes - start), benchmark::Counter::kAvgIterations);
+    }
+}
+
+/*
+ * LWE KEM setup utility methods
+ */
+
+static void LweArgs(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"n", "q", "sigmax10", "eta"});
+    b->Args({512, 3329, 23, 3});
+    b->Args({1024, 3329, 23, 3});
+    b->Args({1024, 3329, 32, 2});
+    b->Threads(1)->Threads(4)->UseRealTime();
+}
+
+// keys, a workspace and the noise of one session; built by each benchmark thread before the timed loop
+template <typename PublicMatrix>
+struct LweBenchSetup {
+    explicit LweBenchSetup(const benchmark::State& state)
+        : n(state.range(0)),
+          q(state.range(1)),
+          stddev(state.range(2) / 10.0),
+          bound(state.range(3)),
+          plaintext(q / 2),
+          ws(n, n, stddev) {
+        KeyGen(n, n, q, stddev, pk, sk, bound);
+        DeriveEncapsNoise(*ws.dgg, pk.hash, plaintext, n, n, bound, ws.r, ws.e1, ws.e2);
+    }
+
+    uint32_t n;
+    uint32_t q;
+    double stddev;
+    int32_t bound;
+    uint32_t plaintext;
+    KemWorkspace ws;
+    KemPublicKey<PublicMatrix> pk;
+    KemSecretKey sk;
+    EncapsResult session;
+};
+
+/*
+ * LWE KEM operations
+ */
+
+template <typename PublicMatrix>
+static void LWEKEM_KeyGen(benchmark::State& state) {
+    const uint32_t n = state.range(0), q = state.range(1);
+    const double stddev = state.range(2) / 10.0;
+    const int32_t bound = state.range(3);
+    KemPublicKey<PublicMatrix> pk;
+    KemSecretKey sk;
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        KeyGen(n, n, q, stddev, pk, sk, bound);
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK_TEMPLATE(LWEKEM_KeyGen, MatrixInt32)->Apply(LweArgs)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(LWEKEM_KeyGen, SeededMatrix)->Apply(LweArgs)->Unit(benchmark::kMillisecond);
+
+template <typename PublicMatrix>
+static void LWEKEM_Encaps(benchmark::State& state) {
+    LweBenchSetup<PublicMatrix> b(state);
+    EncapsResult& res = b.session;
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        Encaps(b.n, b.n, b.q, b.stddev, b.bound, b.pk, res.c.u, res.c.v, b.plaintext, res.K, b.ws);
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK_TEMPLATE(LWEKEM_Encaps, MatrixInt32)->Apply(LweArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(LWEKEM_Encaps, SeededMatrix)->Apply(LweArgs)->Unit(benchmark::kMicrosecond);
+
+template <typename PublicMatrix>
+static void LWEKEM_Decaps(benchmark::State& state) {
+    LweBenchSetup<PublicMatrix> b(state);
+    EncapsResult& res = b.session;
+    Encaps(b.n, b.n, b.q, b.stddev, b.bound, b.pk, res.c.u, res.c.v, b.plaintext, res.K, b.ws);
+    SHA256Digest K;
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        Decaps(res.c.v, res.c.u, b.sk, b.q, b.pk, b.n, b.n, b.stddev, b.bound, K, b.ws);
+        benchmark::DoNotOptimize(K);
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK_TEMPLATE(LWEKEM_Decaps, MatrixInt32)->Apply(LweArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(LWEKEM_Decaps, SeededMatrix)->Apply(LweArgs)->Unit(benchmark::kMicrosecond);
+
+/*
+ * LWE KEM stages: the sum of sampling, matvec and hashing is the cost of one Encaps
+ */
+
+static void LWEKEM_Stage_Sampling(benchmark::State& state) {
+    LweBenchSetup<SeededMatrix> b(state);
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        DeriveEncapsNoise(*b.ws.dgg, b.pk.hash, b.plaintext, b.n, b.n, b.bound, b.ws.r, b.ws.e1, b.ws.e2);
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK(LWEKEM_Stage_Sampling)->Apply(LweArgs)->Unit(benchmark::kMicrosecond);
+
+template <typename PublicMatrix>
+static void LWEKEM_Stage_MatVec(benchmark::State& state) {
+    LweBenchSetup<PublicMatrix> b(state);
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        TransposedProduct(b.pk.A, b.ws.r, b.q, b.ws);
+        benchmark::DoNotOptimize(b.ws.prod.data());
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK_TEMPLATE(LWEKEM_Stage_MatVec, MatrixInt32)->Apply(LweArgs)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(LWEKEM_Stage_MatVec, SeededMatrix)->Apply(LweArgs)->Unit(benchmark::kMicrosecond);
+
+static void LWEKEM_Stage_Hashing(benchmark::State& state) {
+    LweBenchSetup<SeededMatrix> b(state);
+    EncapsResult& res = b.session;
+    Encaps(b.n, b.n, b.q, b.stddev, b.bound, b.pk, res.c.u, res.c.v, b.plaintext, res.K, b.ws);
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        res.K = DeriveSharedKey(b.pk.hash, b.plaintext, res.c.u, res.c.v);
+        benchmark::DoNotOptimize(res.K);
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK(LWEKEM_Stage_Hashing)->Apply(LweArgs)->Unit(benchmark::kMicrosecond);
+
+// encoding and decoding of the public key in seed mode and of a ciphertext in the compressed (kCiphertextDu, kCiphertextDv) wire format
+static void LWEKEM_Stage_Serialization(benchmark::State& state) {
+    LweBenchSetup<SeededMatrix> b(state);
+    EncapsResult& res = b.session;
+    Encaps(b.n, b.n, b.q, b.stddev, b.bound, b.pk, res.c.u, res.c.v, b.plaintext, res.K, b.ws);
+    std::vector<uint8_t> encoded(CiphertextBytes(b.n, kCiphertextDu, kCiphertextDv));
+    KemCiphertext decoded;
+    KemPublicKey<SeededMatrix> pk;
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        std::vector<uint8_t> pkBytes = EncodePublicKey(b.pk);
+        DecodePublicKey(pkBytes.data(), pkBytes.size(), b.n, b.n, b.q, pk);
+        EncodeCiphertext(res.c.u, res.c.v, b.q, kCiphertextDu, kCiphertextDv, encoded.data());
+        DecodeCiphertext(encoded.data(), encoded.size(), b.n, b.q, kCiphertextDu, kCiphertextDv, decoded.u, decoded.v);
+        benchmark::DoNotOptimize(decoded.u.data());
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK(LWEKEM_Stage_Serialization)->Apply(LweArgs)->Unit(benchmark::kMicrosecond);
+
+/*
+ * Module-LWE KEM
+ */
+
+static void MlweArgs(benchmark::internal::Benchmark* b) {
+    b->ArgName("k")->DenseRange(2, 4);
+    b->Threads(1)->Threads(4)->UseRealTime();
+}
+
+static void MLWEKEM_KeyGen(benchmark::State& state) {
+    MlweParams params(state.range(0));
+    MlwePublicKey pk;
+    MlweSecretKey sk;
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        MlweKeyGen(params, pk, sk);
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK(MLWEKEM_KeyGen)->Apply(MlweArgs)->Unit(benchmark::kMicrosecond);
+
+static void MLWEKEM_Encaps(benchmark::State& state) {
+    MlweParams params(state.range(0));
+    MlwePublicKey pk;
+    MlweSecretKey sk;
+    MlweKeyGen(params, pk, sk);
+    MlweCiphertext c;
+    SHA256Digest K;
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        MlweEncaps(params, pk, c, K);
+        benchmark::DoNotOptimize(K);
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK(MLWEKEM_Encaps)->Apply(MlweArgs)->Unit(benchmark::kMicrosecond);
+
+static void MLWEKEM_Decaps(benchmark::State& state) {
+    MlweParams params(state.range(0));
+    MlwePublicKey pk;
+    MlweSecretKey sk;
+    MlweKeyGen(params, pk, sk);
+    MlweCiphertext c;
+    SHA256Digest K;
+    MlweEncaps(params, pk, c, K);
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        MlweDecaps(params, pk, sk, c, K);
+        benchmark::DoNotOptimize(K);
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK(MLWEKEM_Decaps)->Apply(MlweArgs)->Unit(benchmark::kMicrosecond);
+
+// A^T r for a vector r of k polynomials in the NTT domain, as in MlweEncrypt
+static void MLWEKEM_Stage_MatVec(benchmark::State& state) {
+    MlweParams params(state.range(0));
+    MlwePublicKey pk;
+    MlweSecretKey sk;
+    MlweKeyGen(params, pk, sk);
+    std::vector<MlwePoly> u(params.k);
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        for (uint32_t i = 0; i < params.k; ++i)
+            MlweInnerProduct(params, &pk.A[i], params.k, sk.s.data(), u[i]);
+        benchmark::DoNotOptimize(u.data());
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK(MLWEKEM_Stage_MatVec)->Apply(MlweArgs)->Unit(benchmark::kMicrosecond);
+
+// encoding and decoding of a compressed ciphertext
+static void MLWEKEM_Stage_Serialization(benchmark::State& state) {
+    MlweParams params(state.range(0));
+    MlwePublicKey pk;
+    MlweSecretKey sk;
+    MlweKeyGen(params, pk, sk);
+    MlweCiphertext c, decoded;
+    SHA256Digest K;
+    MlweEncaps(params, pk, c, K);
+    std::vector<uint8_t> encoded(MlweCiphertextBytes(params));
+
+    uint64_t start = allocatedBytes;
+    for (auto _ : state) {
+        EncodeMlweCiphertext(params, c, encoded.data());
+        DecodeMlweCiphertext(params, encoded.data(), encoded.size(), decoded);
+        benchmark::DoNotOptimize(encoded.data());
+    }
+    ReportCounters(state, start);
+}
+
+BENCHMARK(MLWEKEM_Stage_Serialization)->Apply(MlweArgs)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
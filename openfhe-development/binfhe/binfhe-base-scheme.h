@@ -101,6 +101,23 @@ public:
     LWECiphertext EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate, const RingGSWBTKey& EK,
                               ConstLWECiphertext& ct1, ConstLWECiphertext& ct2, bool extended = false) const;
 
+    /**
+   * Evaluates several binary gates at once (calls bootstrapping as a subroutine). The
+   * accumulators of all gates are updated in lockstep, so the bootstrapping key is streamed
+   * through the cache once for the whole batch, and the results are key switched in batches
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gates the gates; each can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct1s first input ciphertexts, one per gate
+   * @param ct2s second input ciphertexts, one per gate
+   * @return the resulting ciphertexts, one per gate
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                const std::vector<BINGATE>& gates, const RingGSWBTKey& EK,
+                                                const std::vector<LWECiphertext>& ct1s,
+                                                const std::vector<LWECiphertext>& ct2s, bool extended = false) const;
+
     /**
    * Evaluates a binary gate on a vector of ciphertexts (calls bootstrapping as a subroutine).
    * The evaluation of the gates in this function is specific to 3 input and 4 input
@@ -189,6 +206,28 @@ public:
                                           const NativeInteger& beta) const;
 
 private:
+    /**
+   * Combines the two inputs of a binary gate into the ciphertext to bootstrap
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param EK a shared pointer to the bootstrapping keys
+   * @param ct1 first ciphertext
+   * @param ct2 second ciphertext
+   * @return the ciphertext to bootstrap, modulo q and of dimension n
+   */
+    LWECiphertext EvalBinGateInput(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                   const RingGSWBTKey& EK, ConstLWECiphertext& ct1, ConstLWECiphertext& ct2) const;
+
+    /**
+   * Extracts the result of a binary gate from its accumulator
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param acc the output RingLWE accumulator
+   * @return the resulting ciphertext, modulo Q and of dimension N
+   */
+    LWECiphertext ExtractGateOutput(const std::shared_ptr<BinFHECryptoParams>& params, ConstRLWECiphertext& acc) const;
+
     /**
    * Core bootstrapping operation
    *
@@ -201,6 +240,17 @@ private:
     RLWECiphertext BootstrapGateCore(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
                                      ConstRingGSWACCKey& ek, ConstLWECiphertext& ct) const;
 
+    /**
+   * Initial accumulator of the core bootstrapping operation
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param gate the gate; can be AND, OR, NAND, NOR, XOR, or XOR
+   * @param ct input ciphertext
+   * @return the RingLWE accumulator before the accumulation
+   */
+    RLWECiphertext BootstrapGateInit(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                     ConstLWECiphertext& ct) const;
+
     // Arbitrary function evaluation purposes
 
     /**
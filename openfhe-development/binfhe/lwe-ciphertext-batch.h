@@ -0,0 +1,175 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+#ifndef _LWE_CIPHERTEXT_BATCH_H_
+#define _LWE_CIPHERTEXT_BATCH_H_
+
+#include "lwe-ciphertext.h"
+#include "math/math-hal.h"
+#include "utils/memory.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace lbcrypto {
+/**
+ * @brief Stores a batch of LWE ciphertexts with the same dimension n and modulus
+ * in one cache-line aligned buffer (structure of arrays): the "a" parts are the
+ * rows of a count x stride matrix, where the stride is n rounded up to a whole
+ * number of cache lines, followed by the count "b" parts. Slots are accessed
+ * through LWECiphertextView / ConstLWECiphertextView without copying.
+ */
+class LWECiphertextBatch {
+public:
+    using Buffer = std::vector<NativeInteger, AlignedAllocator<NativeInteger>>;
+
+    LWECiphertextBatch() = default;
+
+    LWECiphertextBatch(uint32_t count, uint32_t n, const NativeInteger& mod)
+        : m_data(static_cast<size_t>(count) * RowStride(n) + count),
+          m_count(count),
+          m_n(n),
+          m_stride(RowStride(n)),
+          m_mod(mod) {}
+
+    /**
+   * @return the number of ciphertexts in the batch
+   */
+    uint32_t GetCount() const {
+        return m_count;
+    }
+
+    /**
+   * @return the dimension n of each ciphertext
+   */
+    uint32_t GetLength() const {
+        return m_n;
+    }
+
+    /**
+   * @return the distance, in integers, between the "a" parts of consecutive ciphertexts
+   */
+    uint32_t GetStride() const {
+        return m_stride;
+    }
+
+    const NativeInteger& GetModulus() const {
+        return m_mod;
+    }
+
+    const NativeInteger& GetptModulus() const {
+        return m_p;
+    }
+
+    void SetptModulus(const NativeInteger& pmod) {
+        m_p = pmod;
+    }
+
+    /**
+   * @return pointer to the first entry of the "a" part of ciphertext i
+   */
+    const NativeInteger* GetA(uint32_t i) const {
+        return m_data.data() + static_cast<size_t>(i) * m_stride;
+    }
+
+    NativeInteger* GetA(uint32_t i) {
+        return m_data.data() + static_cast<size_t>(i) * m_stride;
+    }
+
+    const NativeInteger& GetB(uint32_t i) const {
+        return m_data[static_cast<size_t>(m_count) * m_stride + i];
+    }
+
+    NativeInteger& GetB(uint32_t i) {
+        return m_data[static_cast<size_t>(m_count) * m_stride + i];
+    }
+
+    /**
+   * @return a view of ciphertext i referring to the storage of the batch
+   */
+    LWECiphertextView View(uint32_t i) {
+        return LWECiphertextView(GetA(i), &GetB(i), m_n, m_mod);
+    }
+
+    ConstLWECiphertextView View(uint32_t i) const {
+        return ConstLWECiphertextView(GetA(i), &GetB(i), m_n, m_mod);
+    }
+
+    /**
+   * Copies ciphertext i out of the batch
+   *
+   * @param i index of the ciphertext
+   * @return a shared pointer to a standalone ciphertext
+   */
+    LWECiphertext Get(uint32_t i) const {
+        NativeVector a(m_n, m_mod);
+        const NativeInteger* row = GetA(i);
+        for (uint32_t k = 0; k < m_n; ++k)
+            a[k] = row[k];
+        auto ct = std::make_shared<LWECiphertextImpl>(std::move(a), GetB(i));
+        ct->SetptModulus(m_p);
+        return ct;
+    }
+
+    /**
+   * Copies a ciphertext of the same dimension and modulus into slot i
+   *
+   * @param i index of the ciphertext
+   * @param ct the ciphertext to store
+   */
+    void Set(uint32_t i, ConstLWECiphertext& ct) {
+        if (ct->GetLength() != m_n || ct->GetModulus() != m_mod)
+            OPENFHE_THROW("ciphertext dimension or modulus does not match the batch");
+        std::copy_n(&ct->GetA(0), m_n, GetA(i));
+        GetB(i) = ct->GetB();
+    }
+
+private:
+    // 64-bit integers per cache line
+    static constexpr uint32_t ROW_ALIGN{64 / sizeof(NativeInteger)};
+
+    static uint32_t RowStride(uint32_t n) {
+        return (n + ROW_ALIGN - 1) / ROW_ALIGN * ROW_ALIGN;
+    }
+
+    Buffer m_data{};
+    uint32_t m_count{0};
+    uint32_t m_n{0};
+    uint32_t m_stride{0};
+    NativeInteger m_mod{};
+    NativeInteger m_p = 4;  // pt modulus
+};
+
+}  // namespace lbcrypto
+
+#endif  // _LWE_CIPHERTEXT_BATCH_H_
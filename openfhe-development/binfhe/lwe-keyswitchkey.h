@@ -35,8 +35,10 @@
 #include "lwe-keyswitchkey-fwd.h"
 
 #include "math/math-hal.h"
+#include "utils/memory.h"
 #include "utils/serializable.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -45,54 +47,142 @@
 namespace lbcrypto {
 /**
  * @brief Class that stores the LWE scheme switching key
+ *
+ * Entry (i, j, d) of the key encrypts d * B^j * s_N[i] for the i-th coefficient of the old
+ * secret key, digit position j and digit value d in base B. All "a" parts are kept in one
+ * contiguous, cache-line aligned tensor indexed [i][j][d], with every row padded to whole cache
+ * lines; when the modulus is at most 2^16 they are stored as 16-bit integers, which quarters
+ * the memory traffic of key switching. The "b" parts are kept in one vector with the same order.
  */
 class LWESwitchingKeyImpl : public Serializable {
 public:
+    using CompactTensor = std::vector<uint16_t, AlignedAllocator<uint16_t>>;
+    using WideTensor    = std::vector<NativeInteger::Integer, AlignedAllocator<NativeInteger::Integer>>;
+
     LWESwitchingKeyImpl() = default;
 
-    LWESwitchingKeyImpl(const std::vector<std::vector<std::vector<NativeVector>>>& keyA,
-                        const std::vector<std::vector<std::vector<NativeInteger>>>& keyB)
-        : m_keyA(keyA), m_keyB(keyB) {}
+    /**
+   * Allocates a zero key
+   *
+   * @param N dimension of the old secret key
+   * @param baseKS base B of the digit decomposition
+   * @param digitCount number of digits
+   * @param n dimension of the new secret key
+   * @param qKS modulus of the key
+   */
+    LWESwitchingKeyImpl(uint32_t N, uint32_t baseKS, uint32_t digitCount, uint32_t n, const NativeInteger& qKS)
+        : m_N(N), m_baseKS(baseKS), m_digitCount(digitCount), m_n(n), m_qKS(qKS) {
+        Allocate();
+    }
+
+    uint32_t GetN() const {
+        return m_N;
+    }
+
+    uint32_t GetBaseKS() const {
+        return m_baseKS;
+    }
+
+    uint32_t GetDigitCount() const {
+        return m_digitCount;
+    }
+
+    uint32_t Getn() const {
+        return m_n;
+    }
 
-    LWESwitchingKeyImpl(std::vector<std::vector<std::vector<NativeVector>>>&& keyA,
-                        std::vector<std::vector<std::vector<NativeInteger>>>&& keyB)
-        : m_keyA(std::move(keyA)), m_keyB(std::move(keyB)) {}
+    const NativeInteger& GetModulus() const {
+        return m_qKS;
+    }
 
-    LWESwitchingKeyImpl(const LWESwitchingKeyImpl& rhs) : m_keyA(rhs.m_keyA), m_keyB(rhs.m_keyB) {}
+    /**
+   * @return true if the "a" parts are stored in the 16-bit tensor
+   */
+    bool IsCompact() const {
+        return m_compact;
+    }
 
-    LWESwitchingKeyImpl(LWESwitchingKeyImpl&& rhs) noexcept
-        : m_keyA(std::move(rhs.m_keyA)), m_keyB(std::move(rhs.m_keyB)) {}
+    /**
+   * @return the distance, in entries of the tensor, between consecutive rows
+   */
+    uint32_t GetStride() const {
+        return m_stride;
+    }
 
-    LWESwitchingKeyImpl& operator=(const LWESwitchingKeyImpl& rhs) {
-        m_keyA = rhs.m_keyA;
-        m_keyB = rhs.m_keyB;
-        return *this;
+    /**
+   * @return position of entry (i, j, d) in the vector of "b" parts; multiplied by the stride
+   * it is the position of the row of its "a" part in the tensor
+   */
+    size_t GetIndex(uint32_t i, uint32_t j, uint32_t d) const {
+        return (static_cast<size_t>(i) * m_digitCount + j) * m_baseKS + d;
     }
 
-    LWESwitchingKeyImpl& operator=(LWESwitchingKeyImpl&& rhs) noexcept {
-        m_keyA = std::move(rhs.m_keyA);
-        m_keyB = std::move(rhs.m_keyB);
-        return *this;
+    const CompactTensor& GetCompactA() const {
+        return m_keyA16;
+    }
+
+    CompactTensor& GetCompactA() {
+        return m_keyA16;
+    }
+
+    const WideTensor& GetWideA() const {
+        return m_keyA;
     }
 
-    const std::vector<std::vector<std::vector<NativeVector>>>& GetElementsA() const {
+    WideTensor& GetWideA() {
         return m_keyA;
     }
 
-    const std::vector<std::vector<std::vector<NativeInteger>>>& GetElementsB() const {
+    const std::vector<NativeInteger>& GetElementsB() const {
         return m_keyB;
     }
 
-    void SetElementsA(const std::vector<std::vector<std::vector<NativeVector>>>& keyA) {
-        m_keyA = keyA;
+    std::vector<NativeInteger>& GetElementsB() {
+        return m_keyB;
+    }
+
+    /**
+   * @return the "a" part of entry (i, j, d)
+   */
+    NativeVector GetElementA(uint32_t i, uint32_t j, uint32_t d) const {
+        NativeVector a(m_n, m_qKS);
+        const size_t offset = GetIndex(i, j, d) * m_stride;
+        for (uint32_t k = 0; k < m_n; ++k)
+            a[k] = m_compact ? NativeInteger(m_keyA16[offset + k]) : NativeInteger(m_keyA[offset + k]);
+        return a;
+    }
+
+    void SetElementA(uint32_t i, uint32_t j, uint32_t d, const NativeVector& a) {
+        SetElementA(i, j, d, &a[0]);
+    }
+
+    /**
+   * Sets the "a" part of entry (i, j, d) from n integers below the modulus
+   */
+    void SetElementA(uint32_t i, uint32_t j, uint32_t d, const NativeInteger* a) {
+        const size_t offset = GetIndex(i, j, d) * m_stride;
+        if (m_compact) {
+            for (uint32_t k = 0; k < m_n; ++k)
+                m_keyA16[offset + k] = a[k].ConvertToInt<uint16_t>();
+        }
+        else {
+            for (uint32_t k = 0; k < m_n; ++k)
+                m_keyA[offset + k] = a[k].ConvertToInt<NativeInteger::Integer>();
+        }
     }
 
-    void SetElementsB(const std::vector<std::vector<std::vector<NativeInteger>>>& keyB) {
-        m_keyB = keyB;
+    const NativeInteger& GetElementB(uint32_t i, uint32_t j, uint32_t d) const {
+        return m_keyB[GetIndex(i, j, d)];
+    }
+
+    void SetElementB(uint32_t i, uint32_t j, uint32_t d, const NativeInteger& b) {
+        m_keyB[GetIndex(i, j, d)] = b;
     }
 
     bool operator==(const LWESwitchingKeyImpl& other) const {
-        return (m_keyA == other.m_keyA && m_keyB == other.m_keyB);
+        return (m_N == other.m_N && m_baseKS == other.m_baseKS && m_digitCount == other.m_digitCount &&
+                m_n == other.m_n && m_qKS == other.m_qKS && m_keyA16 == other.m_keyA16 && m_keyA == other.m_keyA &&
+                m_keyB == other.m_keyB);
     }
 
     bool operator!=(const LWESwitchingKeyImpl& other) const {
@@ -101,6 +191,12 @@ public:
 
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
+        ar(::cereal::make_nvp("N", m_N));
+        ar(::cereal::make_nvp("B", m_baseKS));
+        ar(::cereal::make_nvp("d", m_digitCount));
+        ar(::cereal::make_nvp("n", m_n));
+        ar(::cereal::make_nvp("q", m_qKS));
+        ar(::cereal::make_nvp("a16", m_keyA16));
         ar(::cereal::make_nvp("a", m_keyA));
         ar(::cereal::make_nvp("b", m_keyB));
     }
@@ -111,21 +207,63 @@ public:
             OPENFHE_THROW("serialized object version " + std::to_string(version) +
                           " is from a later version of the library");
         }
+        // version 1 stored one NativeVector per entry; its layout cannot be read into the tensor
+        if (version < 2) {
+            OPENFHE_THROW("serialized object version " + std::to_string(version) +
+                          " of the switching key is no longer supported; generate the key again");
+        }
 
+        ar(::cereal::make_nvp("N", m_N));
+        ar(::cereal::make_nvp("B", m_baseKS));
+        ar(::cereal::make_nvp("d", m_digitCount));
+        ar(::cereal::make_nvp("n", m_n));
+        ar(::cereal::make_nvp("q", m_qKS));
+        ar(::cereal::make_nvp("a16", m_keyA16));
         ar(::cereal::make_nvp("a", m_keyA));
         ar(::cereal::make_nvp("b", m_keyB));
+        SetLayout();
+
+        const size_t entries = static_cast<size_t>(m_N) * m_digitCount * m_baseKS;
+        const size_t sizeA   = entries * m_stride;
+        if (m_keyB.size() != entries || (m_compact ? m_keyA16.size() != sizeA || !m_keyA.empty() :
+                                                     m_keyA.size() != sizeA || !m_keyA16.empty()))
+            OPENFHE_THROW("the serialized switching key does not match its dimensions");
     }
 
     std::string SerializedObjectName() const override {
         return "LWEPrivateKey";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
-    std::vector<std::vector<std::vector<NativeVector>>> m_keyA;
-    std::vector<std::vector<std::vector<NativeInteger>>> m_keyB;
+    void SetLayout() {
+        m_compact           = m_qKS <= NativeInteger(uint64_t(1) << 16);
+        const uint32_t line = m_compact ? 64 / sizeof(uint16_t) : 64 / sizeof(NativeInteger::Integer);
+        m_stride            = (m_n + line - 1) / line * line;
+    }
+
+    void Allocate() {
+        SetLayout();
+        const size_t entries = static_cast<size_t>(m_N) * m_digitCount * m_baseKS;
+        if (m_compact)
+            m_keyA16.assign(entries * m_stride, 0);
+        else
+            m_keyA.assign(entries * m_stride, 0);
+        m_keyB.assign(entries, NativeInteger(0));
+    }
+
+    uint32_t m_N{0};
+    uint32_t m_baseKS{0};
+    uint32_t m_digitCount{0};
+    uint32_t m_n{0};
+    NativeInteger m_qKS{0};
+    bool m_compact{false};
+    uint32_t m_stride{0};
+    CompactTensor m_keyA16;
+    WideTensor m_keyA;
+    std::vector<NativeInteger> m_keyB;
 };
 
 }  // namespace lbcrypto
@@ -75,6 +75,24 @@ public:
         OPENFHE_THROW("ACC operation not supported");
     }
 
+    /**
+   * Accumulator function for several independent bootstrappings that share the key: acc[j] is
+   * updated with a[j] for every j. Schemes that can do so override it to apply every key element
+   * to all accumulators in turn; by default the accumulators are updated one after another
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the accumulator key
+   * @param acc previous values of the accumulators
+   * @param a values to update the accumulators with, one per accumulator
+   */
+    virtual void EvalAccBatch(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
+                              std::vector<RLWECiphertext>& acc, const std::vector<NativeVector>& a) const {
+        if (a.size() != acc.size())
+            OPENFHE_THROW("the number of accumulators and of input vectors must match");
+        for (size_t j = 0; j < acc.size(); ++j)
+            EvalAcc(params, ek, acc[j], a[j]);
+    }
+
     /**
    * The signed digit decomposition which takes an RLWE ciphertext input and outputs a vector of its digits, i.e., an
    * RLWE' ciphertext
@@ -0,0 +1,181 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Represents ring elements modulo a 12-bit prime with int16_t coefficients
+ */
+
+#ifndef LBCRYPTO_INC_LATTICE_HAL_DEFAULT_POLY16_H
+#define LBCRYPTO_INC_LATTICE_HAL_DEFAULT_POLY16_H
+
+#include "math/hal/intnat/mubintvecnat16.h"
+#include "math/hal/intnat/transformincomplete.h"
+
+#include "utils/inttypes.h"
+
+#include <memory>
+#include <ostream>
+
+namespace lbcrypto {
+
+/**
+ * @class Poly16
+ * @brief Element of Z_q[X]/(X^n+1) for a 12-bit prime q with n | q-1, stored as an intnat::NativeVector16.
+ *
+ * The EVALUATION format is the incomplete NTT domain of intnat::IncompleteNTT16 (n/2 linear factors), so Times()
+ * is the base-case product rather than a coefficient-wise one. The values are kept in [0, q) in both formats.
+ */
+class Poly16 {
+public:
+    using Vector = intnat::NativeVector16;
+    using Params = intnat::IncompleteNTT16;
+
+    Poly16() = default;
+
+    /**
+     * Creates the zero element.
+     *
+     * @param params the transform, which fixes n and q; shared by all elements of the ring
+     * @param format the format of the element
+     */
+    explicit Poly16(const std::shared_ptr<const Params>& params, Format format = Format::EVALUATION);
+
+    const std::shared_ptr<const Params>& GetParams() const {
+        return m_params;
+    }
+
+    Format GetFormat() const {
+        return m_format;
+    }
+
+    uint32_t GetRingDimension() const {
+        return m_values.GetLength();
+    }
+
+    uint16_t GetModulus() const {
+        return m_values.GetModulus();
+    }
+
+    const Vector& GetValues() const {
+        return m_values;
+    }
+
+    /**
+     * Replaces the values, which are reduced to [0, q).
+     *
+     * @param values n values modulo q
+     * @param format the format of the values
+     */
+    void SetValues(Vector values, Format format);
+
+    int16_t& operator[](uint32_t i) {
+        return m_values[i];
+    }
+
+    const int16_t& operator[](uint32_t i) const {
+        return m_values[i];
+    }
+
+    /**
+     * Switches between COEFFICIENT and EVALUATION formats with the incomplete NTT.
+     */
+    void SwitchFormat();
+
+    void SetFormat(Format format) {
+        if (m_format != format)
+            SwitchFormat();
+    }
+
+    Poly16 Plus(const Poly16& b) const {
+        return Poly16(*this) += b;
+    }
+
+    Poly16 Minus(const Poly16& b) const {
+        return Poly16(*this) -= b;
+    }
+
+    /**
+     * Ring product; both operands must be in EVALUATION format.
+     */
+    Poly16 Times(const Poly16& b) const {
+        return Poly16(*this) *= b;
+    }
+
+    Poly16& operator+=(const Poly16& b);
+    Poly16& operator-=(const Poly16& b);
+    Poly16& operator*=(const Poly16& b);
+
+    /**
+     * this += a * b; all three in EVALUATION format. Accumulates in place, without a temporary element.
+     */
+    Poly16& AddProductEq(const Poly16& a, const Poly16& b);
+
+    /**
+     * Adds b mod q to the value at index i (a coefficient or an NTT-domain value, depending on the format).
+     */
+    Poly16& ModAddAtIndex(uint32_t i, int64_t b) {
+        m_values.ModAddAtIndex(i, b);
+        return *this;
+    }
+
+    bool operator==(const Poly16& b) const {
+        return m_format == b.m_format && m_values == b.m_values;
+    }
+
+    bool operator!=(const Poly16& b) const {
+        return !(*this == b);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Poly16& p);
+
+private:
+    void CheckCompatible(const Poly16& b) const;
+
+    std::shared_ptr<const Params> m_params;
+    Format m_format{Format::EVALUATION};
+    Vector m_values;
+};
+
+inline Poly16 operator+(const Poly16& a, const Poly16& b) {
+    return a.Plus(b);
+}
+
+inline Poly16 operator-(const Poly16& a, const Poly16& b) {
+    return a.Minus(b);
+}
+
+inline Poly16 operator*(const Poly16& a, const Poly16& b) {
+    return a.Times(b);
+}
+
+}  // namespace lbcrypto
+
+#endif
@@ -41,6 +41,7 @@
 
 #include "utils/inttypes.h"
 
+#include <algorithm>
 #include <random>
 
 namespace lbcrypto {
@@ -57,8 +58,17 @@ template <typename VecType>
 VecType BinaryUniformGeneratorImpl<VecType>::GenerateVector(const usint size,
                                                             const typename VecType::Integer& modulus) const {
     VecType v(size, modulus);
-    for (usint i = 0; i < size; i++)
-        v[i] = GenerateInteger();
+
+    // one PRNG bit per value
+    constexpr usint BLOCK{64};
+    uint64_t words[BLOCK];
+    PRNG& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (usint i = 0; i < size; i += 64 * BLOCK) {
+        usint count = std::min(64 * BLOCK, size - i);
+        prng.Fill(words, ((count + 63) / 64) * sizeof(uint64_t));
+        for (usint j = 0; j < count; j++)
+            v[i + j] = typename VecType::Integer((words[j / 64] >> (j % 64)) & 1);
+    }
     return v;
 }
 
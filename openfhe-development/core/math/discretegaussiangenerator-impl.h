@@ -40,6 +40,7 @@
 #include "math/discretegaussiangenerator.h"
 #include "utils/exception.h"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <string>
@@ -48,7 +49,8 @@
 namespace lbcrypto {
 
 template <typename VecType>
-DiscreteGaussianGeneratorImpl<VecType>::DiscreteGaussianGeneratorImpl(double std) {
+DiscreteGaussianGeneratorImpl<VecType>::DiscreteGaussianGeneratorImpl(double std, GaussianSamplingMethod method)
+    : m_method(method) {
     SetStd(std);
 }
 
@@ -67,6 +69,23 @@ void DiscreteGaussianGeneratorImpl<VecType>::SetStd(double std) {
 
     if ((peikert = ((m_std = std) < KARNEY_THRESHOLD)))
         this->Initialize();
+    SetSamplingMethod(m_method);
+}
+
+template <typename VecType>
+GaussianSamplingMethod DiscreteGaussianGeneratorImpl<VecType>::GetSamplingMethod() const {
+    return m_method;
+}
+
+template <typename VecType>
+void DiscreteGaussianGeneratorImpl<VecType>::SetSamplingMethod(GaussianSamplingMethod method) {
+    m_method = method;
+    m_cdt.clear();
+    if (m_method == CDT_CONSTANT_TIME) {
+        if (!peikert)
+            OPENFHE_THROW("CDT sampling requires a standard deviation below KARNEY_THRESHOLD");
+        InitializeCDT();
+    }
 }
 
 template <typename VecType>
@@ -96,8 +115,101 @@ void DiscreteGaussianGeneratorImpl<VecType>::Initialize() {
         m_vals[x] *= m_a;
 }
 
+template <typename VecType>
+void DiscreteGaussianGeneratorImpl<VecType>::InitializeCDT() {
+    // same tail cut as Initialize(); long double keeps the 63-bit entries exact on x86
+    double M{12.00610553538285};
+    int fin{static_cast<int>(std::ceil(m_std * M))};
+    long double variance{2.0L * m_std * m_std};
+
+    std::vector<long double> pdf(fin + 1);
+    long double sum{0.0L};
+    for (int x = 0; x <= fin; ++x) {
+        pdf[x] = (x == 0 ? 1.0L : 2.0L) * std::exp(-(static_cast<long double>(x) * x) / variance);
+        sum += pdf[x];
+    }
+
+    const long double scale{9223372036854775808.0L};  // 2^63
+    long double cusum{0.0L};
+    m_cdt.clear();
+    for (int x = 0; x < fin; ++x) {
+        cusum += pdf[x];
+        long double entry = std::floor(cusum / sum * scale);
+        if (entry >= scale)
+            break;
+        m_cdt.push_back(static_cast<uint64_t>(entry));
+    }
+}
+
+template <typename VecType>
+void DiscreteGaussianGeneratorImpl<VecType>::SampleCDT(const uint64_t* words, int32_t* out, size_t size) const {
+    const uint64_t* table = m_cdt.data();
+    const size_t len      = m_cdt.size();
+    constexpr size_t BLOCK{64};
+    uint64_t mag[BLOCK];
+
+    for (size_t i = 0; i < size; i += BLOCK) {
+        size_t count = std::min(BLOCK, size - i);
+        for (size_t j = 0; j < count; ++j)
+            mag[j] = 0;
+        // |x| = #{k : r >= table[k]}; both operands are below 2^63, so the top bit
+        // of table[k] - 1 - r is set exactly when r >= table[k]
+        for (size_t k = 0; k < len; ++k) {
+            uint64_t t = table[k] - 1;
+            for (size_t j = 0; j < count; ++j)
+                mag[j] += (t - (words[i + j] & 0x7FFFFFFFFFFFFFFFULL)) >> 63;
+        }
+        for (size_t j = 0; j < count; ++j) {
+            int32_t sign = -static_cast<int32_t>(words[i + j] >> 63);
+            out[i + j]   = (static_cast<int32_t>(mag[j]) ^ sign) - sign;
+        }
+    }
+}
+
+template <typename VecType>
+void DiscreteGaussianGeneratorImpl<VecType>::GenerateIntVector(int32_t* out, size_t size) const {
+    GenerateIntVector(PseudoRandomNumberGenerator::GetPRNG(), out, size);
+}
+
+template <typename VecType>
+void DiscreteGaussianGeneratorImpl<VecType>::GenerateIntVector(PRNG& prng, int32_t* out, size_t size) const {
+    if (!peikert) {
+        for (size_t i = 0; i < size; ++i)
+            out[i] = GenerateIntegerKarney(prng, 0, m_std);
+        return;
+    }
+
+    if (m_method == CDT_CONSTANT_TIME) {
+        constexpr size_t BLOCK{256};
+        uint64_t words[BLOCK];
+        for (size_t i = 0; i < size; i += BLOCK) {
+            size_t count = std::min(BLOCK, size - i);
+            prng.Fill(words, count * sizeof(uint64_t));
+            SampleCDT(words, out + i, count);
+        }
+        return;
+    }
+
+    std::uniform_real_distribution<double> distribution(0.0, 1.0);
+    for (size_t i = 0; i < size; ++i) {
+        // we need to use the binary uniform generator rather than regular
+        // continuous distribution; see DG14 for details
+        double seed = distribution(prng) - 0.5;
+        double tmp  = std::abs(seed) - m_a / 2;
+        int32_t val = 0;
+        if (tmp > 0)
+            val = static_cast<int32_t>(FindInVector(m_vals, tmp)) * (seed > 0 ? 1 : -1);
+        out[i] = val;
+    }
+}
+
 template <typename VecType>
 int32_t DiscreteGaussianGeneratorImpl<VecType>::GenerateInt() const {
+    if (m_method == CDT_CONSTANT_TIME) {
+        int32_t val;
+        GenerateIntVector(&val, 1);
+        return val;
+    }
     // we need to use the binary uniform generator rather than regular continuous
     // distribution; see DG14 for details
     double seed = std::uniform_real_distribution<double>(0.0, 1.0)(PseudoRandomNumberGenerator::GetPRNG()) - 0.5;
@@ -117,17 +229,10 @@ std::shared_ptr<int64_t> DiscreteGaussianGeneratorImpl<VecType>::GenerateIntVect
         return ans;
     }
 
-    std::uniform_real_distribution<double> distribution(0.0, 1.0);
-    for (uint32_t i = 0; i < size; ++i) {
-        // we need to use the binary uniform generator rather than regular
-        // continuous distribution; see DG14 for details
-        double seed = distribution(PseudoRandomNumberGenerator::GetPRNG()) - 0.5;
-        double tmp  = std::abs(seed) - m_a / 2;
-        int64_t val = 0;
-        if (tmp > 0)
-            val = static_cast<int64_t>(FindInVector(m_vals, tmp)) * (seed > 0 ? 1 : -1);
-        (ans.get())[i] = val;
-    }
+    std::vector<int32_t> vals(size);
+    GenerateIntVector(vals.data(), size);
+    for (uint32_t i = 0; i < size; ++i)
+        (ans.get())[i] = vals[i];
     return ans;
 }
 
@@ -144,11 +249,7 @@ uint32_t DiscreteGaussianGeneratorImpl<VecType>::FindInVector(const std::vector<
 template <typename VecType>
 typename VecType::Integer DiscreteGaussianGeneratorImpl<VecType>::GenerateInteger(
     const typename VecType::Integer& modulus) const {
-    double seed = std::uniform_real_distribution<double>(0.0, 1.0)(PseudoRandomNumberGenerator::GetPRNG()) - 0.5;
-    double tmp  = std::abs(seed) - m_a / 2;
-    if (tmp <= 0)
-        return typename VecType::Integer(0);
-    auto val = static_cast<int32_t>(FindInVector(m_vals, tmp)) * (seed > 0 ? 1 : -1);
+    auto val = GenerateInt();
     if (val < 0)
         return modulus - typename VecType::Integer(-val);
     return typename VecType::Integer(val);
@@ -222,11 +323,14 @@ int32_t DiscreteGaussianGeneratorImpl<VecType>::GenerateInteger(double mean, dou
 
 template <typename VecType>
 int64_t DiscreteGaussianGeneratorImpl<VecType>::GenerateIntegerKarney(double mean, double stddev) {
+    return GenerateIntegerKarney(PseudoRandomNumberGenerator::GetPRNG(), mean, stddev);
+}
+
+template <typename VecType>
+int64_t DiscreteGaussianGeneratorImpl<VecType>::GenerateIntegerKarney(PRNG& g, double mean, double stddev) {
     std::uniform_int_distribution<int64_t> uniform_sign(0, 1);
     std::uniform_int_distribution<int64_t> uniform_j(0, std::ceil(stddev) - 1);
 
-    PRNG& g = PseudoRandomNumberGenerator::GetPRNG();
-
     while (true) {
         // STEP D1
         int32_t k = AlgorithmG(g);
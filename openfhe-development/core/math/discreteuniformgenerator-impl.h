@@ -41,6 +41,9 @@
 #include "math/distributiongenerator.h"
 #include "utils/exception.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace lbcrypto {
 
 template <typename VecType>
@@ -79,11 +82,48 @@ typename VecType::Integer DiscreteUniformGeneratorImpl<VecType>::GenerateInteger
     }
 }
 
+template <typename VecType>
+template <typename Word>
+void DiscreteUniformGeneratorImpl<VecType>::GenerateVectorMaskAndReject(VecType& v, uint32_t size) const {
+    const uint64_t modulus = m_modulus.template ConvertToInt<uint64_t>();
+    const usint bits       = (m_modulus - typename VecType::Integer(1)).GetMSB();
+    const Word mask        = (bits >= 8 * sizeof(Word)) ? std::numeric_limits<Word>::max() : ((Word(1) << bits) - 1);
+
+    constexpr uint32_t BLOCK{256};
+    Word words[BLOCK];
+    PRNG& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (uint32_t i = 0; i < size;) {
+        uint32_t count = std::min(BLOCK, size - i);
+        prng.Fill(words, count * sizeof(Word));
+        for (uint32_t j = 0; j < count; ++j) {
+            Word value = words[j] & mask;
+            if (value < modulus)
+                v[i++] = typename VecType::Integer(static_cast<uint64_t>(value));
+        }
+    }
+}
+
 template <typename VecType>
 VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVector(const uint32_t size) const {
+    if (m_modulus == typename VecType::Integer(0))
+        OPENFHE_THROW("0 modulus?");
+
     VecType v(size, m_modulus);
-    for (uint32_t i = 0; i < size; ++i)
-        v[i] = this->GenerateInteger();
+    usint msb = m_modulus.GetMSB();
+    // the narrowest word that holds the masked values, to draw as few PRNG bytes as possible
+    if (msb <= 16) {
+        GenerateVectorMaskAndReject<uint16_t>(v, size);
+    }
+    else if (msb <= 32) {
+        GenerateVectorMaskAndReject<uint32_t>(v, size);
+    }
+    else if (msb <= 64) {
+        GenerateVectorMaskAndReject<uint64_t>(v, size);
+    }
+    else {
+        for (uint32_t i = 0; i < size; ++i)
+            v[i] = this->GenerateInteger();
+    }
     return v;
 }
 
@@ -91,10 +131,7 @@ template <typename VecType>
 VecType DiscreteUniformGeneratorImpl<VecType>::GenerateVector(const uint32_t size,
                                                               const typename VecType::Integer& modulus) {
     this->SetModulus(modulus);
-    VecType v(size, m_modulus);
-    for (uint32_t i = 0; i < size; ++i)
-        v[i] = this->GenerateInteger();
-    return v;
+    return this->GenerateVector(size);
 }
 
 }  // namespace lbcrypto
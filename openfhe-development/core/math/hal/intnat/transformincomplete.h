@@ -0,0 +1,195 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Incomplete negacyclic NTT with 16-bit Montgomery arithmetic for small moduli
+ */
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMINCOMPLETE_H
+#define LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMINCOMPLETE_H
+
+#include "math/hal/intnat/mubintvecnat16.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace intnat {
+
+/**
+ * @brief Incomplete number theoretic transform in the ring Z_q[X]/(X^n+1) for a prime q < 2^12 and power-of-two
+ * n s.t. n|q-1 (but not necessarily 2n|q-1, e.g. q = 3329 and n = 256).
+ *
+ * Without a 2n-th root of unity, X^n+1 only splits into the n/2 factors X^2 - zeta_i, so the transform stops one
+ * layer early and an element in the NTT domain is a vector of n/2 linear polynomials (pairs of coefficients).
+ * Multiplication in the NTT domain is the base-case product of these pairs modulo X^2 - zeta_i.
+ *
+ * Coefficients are int16_t. Modular products use signed Montgomery reduction with R = 2^16 and sums use Barrett
+ * reduction, following the Kyber reference implementation. When the CPU supports AVX2 the butterflies and the
+ * base-case multiplication process 16 coefficients at a time; the results are identical to the scalar code.
+ */
+class IncompleteNTT16 {
+public:
+    /**
+     * @param n the ring dimension, a power of two >= 4 s.t. n|q-1
+     * @param modulus the prime modulus q < 2^12
+     * @param allowAVX2 if false, the scalar code is used even when the CPU supports AVX2
+     */
+    IncompleteNTT16(uint32_t n, uint16_t modulus, bool allowAVX2 = true);
+
+    uint32_t GetRingDimension() const {
+        return m_n;
+    }
+
+    uint16_t GetModulus() const {
+        return static_cast<uint16_t>(m_modulus.q);
+    }
+
+    /**
+     * @return the primitive n-th root of unity zeta in [0, q) used by the transform (the smallest one)
+     */
+    uint16_t GetRootOfUnity() const {
+        return m_root;
+    }
+
+    /**
+     * @return true if the transform uses the AVX2 kernels
+     */
+    bool UsesAVX2() const {
+        return m_avx2;
+    }
+
+    /**
+     * In-place forward transform, bit-reversed order of the pairs.
+     *
+     * @param[in,out] element n coefficients with absolute value at most q; on output the NTT-domain values in
+     * [0, q]
+     */
+    void ForwardTransform(int16_t* element) const;
+
+    /**
+     * In-place inverse of ForwardTransform().
+     *
+     * @param[in,out] element n NTT-domain values with absolute value less than q; on output the coefficients
+     * in (-q, q)
+     */
+    void InverseTransform(int16_t* element) const;
+
+    /**
+     * Base-case multiplication of two elements in the NTT domain. The result is scaled by the Montgomery factor
+     * 2^{-16}; ToMontgomery() applied once to a sum of such products removes it.
+     *
+     * @param a, b n NTT-domain values with absolute value at most q
+     * @param[out] result n values with absolute value less than 2q (may alias a or b)
+     */
+    void BaseCaseMultiply(const int16_t* a, const int16_t* b, int16_t* result) const;
+
+    /**
+     * Adds the base-case product of two elements in the NTT domain to an accumulator, without the Montgomery
+     * factor and without a temporary buffer.
+     *
+     * @param a, b n NTT-domain values with absolute value at most q
+     * @param[in,out] acc n values in [0, q); on output acc + a * b in [0, q) (may alias a or b)
+     */
+    void BaseCaseMultiplyAdd(const int16_t* a, const int16_t* b, int16_t* acc) const;
+
+    /**
+     * Multiplies every coefficient by 2^16 mod q.
+     *
+     * @param[in,out] element n values; on output in (-q, q)
+     */
+    void ToMontgomery(int16_t* element) const;
+
+    /**
+     * Reduces every coefficient to the canonical representative in [0, q).
+     *
+     * @param[in,out] element n values
+     */
+    void Reduce(int16_t* element) const;
+
+    /**
+     * @return a * 2^{-16} mod q in (-q, q) for |a| < q * 2^15
+     */
+    int16_t MontgomeryReduce(int32_t a) const {
+        return m_modulus.MontgomeryReduce(a);
+    }
+
+    /**
+     * @return a * b * 2^{-16} mod q in (-q, q)
+     */
+    int16_t MontgomeryMultiply(int16_t a, int16_t b) const {
+        return m_modulus.MontgomeryMultiply(a, b);
+    }
+
+    /**
+     * @return a representative of a mod q in [0, q]
+     */
+    int16_t BarrettReduce(int16_t a) const {
+        return m_modulus.BarrettReduce(a);
+    }
+
+    /**
+     * @return the constants and scalar reductions of the modulus
+     */
+    const Modulus16& GetModulus16() const {
+        return m_modulus;
+    }
+
+private:
+    void ForwardTransformScalar(int16_t* element) const;
+    void InverseTransformScalar(int16_t* element) const;
+    void BaseCaseMultiplyScalar(const int16_t* a, const int16_t* b, int16_t* result) const;
+    void BaseCaseMultiplyAddScalar(const int16_t* a, const int16_t* b, int16_t* acc) const;
+
+    uint32_t m_n;
+    Modulus16 m_modulus;
+    uint16_t m_root;
+    // 2^16 * (n/2)^{-1} mod q, centered: the Montgomery product with it divides by n/2
+    int16_t m_inverseScale;
+    bool m_avx2;
+
+    // zeta^{brv(k)} * 2^16 for k in [1, n/2), centered; used by the butterflies of index k
+    std::vector<int16_t> m_zetas;
+    // -zeta^{-brv(k)} * 2^16, centered; used by the inverse butterflies of index k
+    std::vector<int16_t> m_zetasInverse;
+
+    // AVX2 tables (empty otherwise): per 32-coefficient block, the 16 zetas of the last three layers, of the
+    // inverse layers and of the base-case multiplication in the lane order of the kernels, each followed by the
+    // same 16 values times q^{-1} mod 2^16
+    std::vector<int16_t> m_laneZetas;
+    std::vector<int16_t> m_laneZetasInverse;
+    std::vector<int16_t> m_laneZetasBaseCase;
+
+    friend struct IncompleteNTT16AVX2;
+};
+
+}  // namespace intnat
+
+#endif
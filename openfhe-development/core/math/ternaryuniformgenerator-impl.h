@@ -41,14 +41,31 @@
 
 #include "utils/inttypes.h"
 
+#include <algorithm>
 #include <memory>
 #include <random>
+#include <vector>
 
 namespace lbcrypto {
 
 template <typename VecType>
-std::uniform_int_distribution<int> TernaryUniformGeneratorImpl<VecType>::m_distribution =
-    std::uniform_int_distribution<int>(-1, 1);
+void TernaryUniformGeneratorImpl<VecType>::FillTernary(int32_t* out, usint size) {
+    constexpr usint BLOCK{256};
+    uint8_t bytes[BLOCK];
+    PRNG& prng = PseudoRandomNumberGenerator::GetPRNG();
+    for (usint i = 0; i < size;) {
+        // every byte yields 3 values on average
+        usint count = std::min(BLOCK, (size - i + 2) / 3);
+        prng.Fill(bytes, count);
+        for (usint j = 0; j < count && i < size; ++j) {
+            for (usint k = 0; k < 8 && i < size; k += 2) {
+                int32_t candidate = (bytes[j] >> k) & 3;
+                if (candidate != 3)
+                    out[i++] = candidate - 1;
+            }
+        }
+    }
+}
 
 template <typename VecType>
 VecType TernaryUniformGeneratorImpl<VecType>::GenerateVector(usint size, const typename VecType::Integer& modulus,
@@ -59,14 +76,14 @@ VecType TernaryUniformGeneratorImpl<VecType>::GenerateVector(usint size, const t
     if (h == 0) {
         // regular ternary distribution
 
-        int32_t randomNumber;
+        std::vector<int32_t> values(size);
+        FillTernary(values.data(), size);
 
         for (usint i = 0; i < size; i++) {
-            randomNumber = m_distribution(PseudoRandomNumberGenerator::GetPRNG());
-            if (randomNumber < 0)
+            if (values[i] < 0)
                 v[i] = modulus - typename VecType::Integer(1);
             else
-                v[i] = typename VecType::Integer(randomNumber);
+                v[i] = typename VecType::Integer(values[i]);
         }
     }
     else {
@@ -113,9 +130,7 @@ std::shared_ptr<int32_t> TernaryUniformGeneratorImpl<VecType>::GenerateIntVector
     std::shared_ptr<int32_t> ans(new int32_t[size], std::default_delete<int32_t[]>());
 
     if (h == 0) {
-        for (usint i = 0; i < size; i++) {
-            (ans.get())[i] = m_distribution(PseudoRandomNumberGenerator::GetPRNG());
-        }
+        FillTernary(ans.get(), size);
     }
     else {
         int32_t randomIndex;
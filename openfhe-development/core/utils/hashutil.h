@@ -37,24 +37,130 @@
 #define _SRC_LIB_UTILS_HASHUTIL_H
 
 #include <utils/exception.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace lbcrypto {
 
-enum HashAlgorithm { SHA_256 = 0, SHA_512 = 1 };
+enum HashAlgorithm { SHA_256 = 0, SHA_512 = 1, SHA3_256 = 2, SHA3_512 = 3, SHAKE_128 = 4, SHAKE_256 = 5 };
+
+using SHA256Digest = std::array<uint8_t, 32>;
+using SHA512Digest = std::array<uint8_t, 64>;
+
+/**
+ * @brief Incremental SHA-256. Update() may be called any number of times with arbitrary
+ * chunks, so large inputs can be hashed piece by piece without materializing them.
+ * Final() writes the digest and resets the hasher for reuse.
+ */
+class SHA256Hasher {
+public:
+    SHA256Hasher() {
+        Init();
+    }
+
+    void Init();
+    void Update(const void* data, size_t length);
+    void Final(uint8_t* digest);
+
+    SHA256Digest Final() {
+        SHA256Digest digest;
+        Final(digest.data());
+        return digest;
+    }
+
+private:
+    uint32_t m_state[8];
+    uint8_t m_buffer[64];
+    size_t m_bufferLen;
+    uint64_t m_length;
+};
+
+/**
+ * @brief Keccak sponge implementing SHA3-256, SHA3-512 (FIPS 202 hashes) and the SHAKE128/SHAKE256
+ * extendable-output functions. Update() absorbs arbitrary chunks; the first call to Squeeze() pads the
+ * input, and for SHAKE further calls continue the output stream. Init() resets the sponge for reuse.
+ */
+class KeccakHasher {
+public:
+    explicit KeccakHasher(HashAlgorithm algo = SHAKE_128);
+
+    void Init();
+    void Update(const void* data, size_t length);
+    void Squeeze(uint8_t* out, size_t length);
+
+    /**
+     * @brief number of bytes absorbed or squeezed per Keccak-f[1600] permutation
+     */
+    size_t Rate() const {
+        return m_rate;
+    }
+
+private:
+    uint64_t m_state[25];
+    size_t m_rate;
+    size_t m_pos;
+    uint8_t m_domain;
+    bool m_squeezing;
+};
+
+/**
+ * @brief Four independent Keccak sponges advanced together. Each permutation call runs the four
+ * Keccak-f[1600] instances in the lanes of AVX2 registers when the CPU supports it, so that
+ * e.g. four rows of a public matrix are expanded for about the cost of one SHAKE stream.
+ */
+class KeccakHasherX4 {
+public:
+    explicit KeccakHasherX4(HashAlgorithm algo = SHAKE_128);
+
+    /**
+     * @brief resets the sponges and absorbs (and pads) 4 messages of the same length
+     * @param messages array of 4 pointers to the messages
+     * @param length length in bytes of every message
+     */
+    void Absorb(const void* const* messages, size_t length);
+
+    /**
+     * @brief squeezes nblocks * Rate() bytes into each of the 4 outputs
+     * @param outputs array of 4 output buffers
+     * @param nblocks number of rate-sized blocks
+     */
+    void SqueezeBlocks(uint8_t* const* outputs, size_t nblocks);
+
+    size_t Rate() const {
+        return m_rate;
+    }
+
+private:
+    // word i of instance j is stored at m_state[4 * i + j]
+    alignas(32) uint64_t m_state[100];
+    size_t m_rate;
+    uint8_t m_domain;
+};
 
 class HashUtil {
+    friend class SHA256Hasher;
+    friend class KeccakHasher;
+    friend class KeccakHasherX4;
+
 public:
-    static void Hash(std::string message, HashAlgorithm algo, std::vector<int64_t>& digest) {
+    static void Hash(const std::string& message, HashAlgorithm algo, std::vector<int64_t>& digest) {
         switch (algo) {
             case SHA_256:
                 SHA256(message, digest);
                 return;
 
             case SHA_512:
-                // TODO SHA512 disabled, returning SHA256 instead
-                SHA256(message, digest);
+                SHA512(message, digest);
+                return;
+
+            case SHA3_256:
+            case SHA3_512:
+            case SHAKE_128:
+            case SHAKE_256:
+                Keccak(message, algo, digest);
                 return;
 
             default:
@@ -62,11 +168,98 @@ public:
         }
     }
 
-    static std::string HashString(std::string message);
+    static std::string HashString(const std::string& message);
+
+    /**
+     * @brief Computes SHA-256 directly over a byte buffer, without building an intermediate string
+     * @param message pointer to the bytes to hash
+     * @param length number of bytes
+     * @param digest output buffer of 32 bytes
+     */
+    static void SHA256Bytes(const void* message, size_t length, uint8_t* digest) {
+        SHA256Hasher hasher;
+        hasher.Update(message, length);
+        hasher.Final(digest);
+    }
+
+    static SHA256Digest SHA256Bytes(const void* message, size_t length) {
+        SHA256Digest digest;
+        SHA256Bytes(message, length, digest.data());
+        return digest;
+    }
+
+    /**
+     * @brief Hashes count independent messages of the same length. Groups of 8 messages are
+     * processed in parallel in the lanes of AVX2 registers when the CPU supports it
+     * @param messages array of count pointers to the messages
+     * @param length length in bytes of every message
+     * @param count number of messages
+     * @param digests output array of count digests
+     */
+    static void SHA256Multi(const void* const* messages, size_t length, size_t count, SHA256Digest* digests);
+
+    /**
+     * @brief SHA256Multi that always takes the 8-lane AVX2 path, which SHA256Multi skips on CPUs
+     * with the SHA extensions; used to test that path. The CPU must support AVX2 (on other
+     * architectures the messages are hashed one at a time)
+     */
+    static void SHA256MultiAVX2(const void* const* messages, size_t length, size_t count, SHA256Digest* digests);
+
+    /**
+     * @brief Computes SHA-512 directly over a byte buffer
+     * @param message pointer to the bytes to hash
+     * @param length number of bytes
+     * @param digest output buffer of 64 bytes
+     */
+    static void SHA512Bytes(const void* message, size_t length, uint8_t* digest);
+
+    static SHA512Digest SHA512Bytes(const void* message, size_t length) {
+        SHA512Digest digest;
+        SHA512Bytes(message, length, digest.data());
+        return digest;
+    }
+
+    /**
+     * @brief Computes SHA3-256 over a byte buffer
+     * @param message pointer to the bytes to hash
+     * @param length number of bytes
+     * @param digest output buffer of 32 bytes
+     */
+    static void SHA3_256Bytes(const void* message, size_t length, uint8_t* digest);
+
+    /**
+     * @brief Computes SHA3-512 over a byte buffer
+     * @param message pointer to the bytes to hash
+     * @param length number of bytes
+     * @param digest output buffer of 64 bytes
+     */
+    static void SHA3_512Bytes(const void* message, size_t length, uint8_t* digest);
+
+    /**
+     * @brief Computes outLength bytes of SHAKE128 output over a byte buffer
+     */
+    static void SHAKE128(const void* message, size_t length, uint8_t* out, size_t outLength);
+
+    /**
+     * @brief Computes outLength bytes of SHAKE256 output over a byte buffer
+     */
+    static void SHAKE256(const void* message, size_t length, uint8_t* out, size_t outLength);
 
 private:
-    static void SHA256(std::string message, std::vector<int64_t>& digest);
-    static void SHA512(std::string message, std::vector<int64_t>& digest);
+    static void SHA256(const std::string& message, std::vector<int64_t>& digest);
+    static void SHA512(const std::string& message, std::vector<int64_t>& digest);
+    // SHA-3 digests, and 32 (SHAKE128) or 64 (SHAKE256) bytes of SHAKE output
+    static void Keccak(const std::string& message, HashAlgorithm algo, std::vector<int64_t>& digest);
+    static void KeccakF1600(uint64_t* state);
+    // four interleaved states, word i of instance j at state[4 * i + j]
+    static void KeccakF1600x4(uint64_t* state);
+    // compresses nblocks consecutive 64-byte blocks; the implementation (SHA extensions or
+    // portable C++) is selected at runtime
+    static void SHA256Compress(uint32_t* h_256, const uint8_t* blocks, size_t nblocks);
+    static void SHA256CompressGeneric(uint32_t* h_256, const uint8_t* blocks, size_t nblocks);
+    static void SHA256CompressSHANI(uint32_t* h_256, const uint8_t* blocks, size_t nblocks);
+    static void SHA256x8AVX2(const uint8_t* const* messages, size_t length, SHA256Digest* digests);
+    static void SHA512Compress(uint64_t* h_512, const uint8_t* block);
     static const uint32_t k_256[64];
     static const uint64_t k_512[80];
 };
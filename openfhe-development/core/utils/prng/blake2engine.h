@@ -81,6 +81,12 @@ class Blake2Engine : public PRNG {
         return result;
     }
 
+    /**
+     * @brief copies the buffered samples in bulk; whole buffers are generated
+     * directly into the output
+     */
+    void Fill(void* buffer, size_t nbytes) override;
+
  private:
     /**
      * @brief The main call to blake2xb function
@@ -48,7 +48,9 @@
 #ifndef __PRNG_H__
 #define __PRNG_H__
 
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 
 // ATTENTION (VERY IMPORTANT):
@@ -79,6 +81,27 @@ public:
     virtual result_type operator()() = 0;
     virtual ~PRNG()                  = default;
 
+    /**
+     * @brief fills a buffer with pseudorandom bytes taken from the same stream as operator().
+     * The default implementation copies one result_type per call to operator(); engines
+     * should override it to copy their internal output in bulk. A trailing partial
+     * result_type consumes a whole value of the stream.
+     * @param buffer the output buffer
+     * @param nbytes the number of bytes to write
+     * @note engines loaded from an external library must be rebuilt against this header
+     */
+    virtual void Fill(void* buffer, size_t nbytes) {
+        uint8_t* out = static_cast<uint8_t*>(buffer);
+        for (; nbytes >= sizeof(result_type); out += sizeof(result_type), nbytes -= sizeof(result_type)) {
+            result_type value = (*this)();
+            std::memcpy(out, &value, sizeof(value));
+        }
+        if (nbytes > 0) {
+            result_type value = (*this)();
+            std::memcpy(out, &value, nbytes);
+        }
+    }
+
 protected:
     PRNG() = default;
 };
@@ -52,4 +52,7 @@ CEREAL_REGISTER_TYPE(lbcrypto::RingGSWACCKeyImpl);
 CEREAL_REGISTER_TYPE(lbcrypto::BinFHECryptoParams);
 CEREAL_REGISTER_TYPE(lbcrypto::BinFHEContext);
 
+// load() rejects switching keys serialized in the old layout, so the version must be written
+CEREAL_CLASS_VERSION(lbcrypto::LWESwitchingKeyImpl, lbcrypto::LWESwitchingKeyImpl::SerializedVersion());
+
 #endif
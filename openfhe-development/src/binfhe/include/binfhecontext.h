@@ -228,6 +228,19 @@ public:
     LWECiphertext Encrypt(ConstLWEPublicKey& pk, LWEPlaintext m, BINFHE_OUTPUT output = SMALL_DIM,
                           LWEPlaintextModulus p = 4, const NativeInteger& mod = 0) const;
 
+    /**
+   * Encrypts a batch of bits or integers using a secret key (symmetric key encryption) into one
+   * contiguous ciphertext batch
+   *
+   * @param sk the secret key
+   * @param m the plaintexts
+   * @param p plaintext modulus
+   * @param mod the ciphertext modulus to encrypt with; by default m_q in params
+   * @return the batch of ciphertexts, ciphertext i encrypting m[i]
+   */
+    LWECiphertextBatch EncryptBatch(ConstLWEPrivateKey& sk, const std::vector<LWEPlaintext>& m,
+                                    LWEPlaintextModulus p = 4, const NativeInteger& mod = 0) const;
+
     /**
    * Converts a ciphertext (public key encryption) with modulus Q and dimension N to ciphertext with q and n
    *
@@ -247,6 +260,17 @@ public:
    */
     void Decrypt(ConstLWEPrivateKey& sk, ConstLWECiphertext& ct, LWEPlaintext* result, LWEPlaintextModulus p = 4) const;
 
+    /**
+   * Decrypts a batch of ciphertexts using a secret key
+   *
+   * @param sk the secret key
+   * @param ct the batch of ciphertexts
+   * @param result plaintext results, one per ciphertext
+   * @param p plaintext modulus
+   */
+    void DecryptBatch(ConstLWEPrivateKey& sk, const LWECiphertextBatch& ct, std::vector<LWEPlaintext>* result,
+                      LWEPlaintextModulus p = 4) const;
+
     /**
    * Generates a switching key to go from a secret key with (Q,N) to a secret
    * key with (q,n)
@@ -304,6 +328,19 @@ public:
    */
     LWECiphertext EvalBinGate(BINGATE gate, ConstLWECiphertext& ct1, ConstLWECiphertext& ct2, bool extended = false) const;
 
+    /**
+   * Evaluates several binary gates at once (calls bootstrapping as a subroutine); every
+   * bootstrapping key element is loaded once and applied to all gates
+   *
+   * @param gates the gates; each can be AND, OR, NAND, NOR, XOR, or XNOR
+   * @param ct1s first input ciphertexts, one per gate
+   * @param ct2s second input ciphertexts, one per gate
+   * @return the resulting ciphertexts, ciphertext i being gates[i](ct1s[i], ct2s[i])
+   */
+    std::vector<LWECiphertext> EvalBinGateBatch(const std::vector<BINGATE>& gates,
+                                                const std::vector<LWECiphertext>& ct1s,
+                                                const std::vector<LWECiphertext>& ct2s, bool extended = false) const;
+
     /**
    * Evaluates a binary gate on vector of ciphertexts (calls bootstrapping as a subroutine)
    *
@@ -161,6 +161,87 @@ private:
     NativeInteger m_p = 4;  // pt modulus
 };
 
+/**
+ * @brief Non-owning view of one LWE ciphertext: "a" is n contiguous integers and "b" a single
+ * integer, both modulo the same modulus. A view refers either to an LWECiphertextImpl or to a
+ * slot of an LWECiphertextBatch, and is valid as long as that storage is not resized or destroyed.
+ */
+class LWECiphertextView {
+public:
+    LWECiphertextView(NativeInteger* a, NativeInteger* b, uint32_t n, const NativeInteger& mod)
+        : m_a(a), m_b(b), m_n(n), m_mod(mod) {}
+
+    explicit LWECiphertextView(LWECiphertextImpl& ct)
+        : m_a(&ct.GetA(0)), m_b(&ct.GetB()), m_n(ct.GetLength()), m_mod(ct.GetModulus()) {}
+
+    NativeInteger* GetA() const {
+        return m_a;
+    }
+
+    NativeInteger& GetA(std::size_t i) const {
+        return m_a[i];
+    }
+
+    NativeInteger& GetB() const {
+        return *m_b;
+    }
+
+    const NativeInteger& GetModulus() const {
+        return m_mod;
+    }
+
+    uint32_t GetLength() const {
+        return m_n;
+    }
+
+private:
+    NativeInteger* m_a;
+    NativeInteger* m_b;
+    uint32_t m_n;
+    NativeInteger m_mod;
+};
+
+/**
+ * @brief Read-only counterpart of LWECiphertextView
+ */
+class ConstLWECiphertextView {
+public:
+    ConstLWECiphertextView(const NativeInteger* a, const NativeInteger* b, uint32_t n, const NativeInteger& mod)
+        : m_a(a), m_b(b), m_n(n), m_mod(mod) {}
+
+    ConstLWECiphertextView(const LWECiphertextView& ct)  // NOLINT
+        : m_a(ct.GetA()), m_b(&ct.GetB()), m_n(ct.GetLength()), m_mod(ct.GetModulus()) {}
+
+    explicit ConstLWECiphertextView(const LWECiphertextImpl& ct)
+        : m_a(&ct.GetA(0)), m_b(&ct.GetB()), m_n(ct.GetLength()), m_mod(ct.GetModulus()) {}
+
+    const NativeInteger* GetA() const {
+        return m_a;
+    }
+
+    const NativeInteger& GetA(std::size_t i) const {
+        return m_a[i];
+    }
+
+    const NativeInteger& GetB() const {
+        return *m_b;
+    }
+
+    const NativeInteger& GetModulus() const {
+        return m_mod;
+    }
+
+    uint32_t GetLength() const {
+        return m_n;
+    }
+
+private:
+    const NativeInteger* m_a;
+    const NativeInteger* m_b;
+    uint32_t m_n;
+    NativeInteger m_mod;
+};
+
 }  // namespace lbcrypto
 
 #endif  // _LWE_CIPHERTEXT_H_
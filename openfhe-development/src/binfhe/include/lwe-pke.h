@@ -34,6 +34,7 @@
 
 #include "binfhe-constants.h"
 #include "lwe-ciphertext.h"
+#include "lwe-ciphertext-batch.h"
 #include "lwe-keyswitchkey.h"
 #include "lwe-privatekey.h"
 #include "lwe-publickey.h"
@@ -41,6 +42,7 @@
 #include "lwe-cryptoparameters.h"
 
 #include <memory>
+#include <vector>
 
 namespace lbcrypto {
 
@@ -113,6 +115,38 @@ public:
     LWECiphertext EncryptN(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPublicKey& pk, LWEPlaintext m,
                            LWEPlaintextModulus p = 4, NativeInteger mod = 0) const;
 
+    /**
+   * Encrypts a batch of plaintexts using a secret key (symmetric key encryption). The secret
+   * key is prepared once for the whole batch and the inner products <a_i, s> are computed as
+   * one matrix-vector product over the contiguous "a" matrix of the batch.
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param sk the secret key
+   * @param m the plaintexts
+   * @param p the plaintext space
+   * @param mod the ciphertext modulus to encrypt with; by default m_q in params
+   * @return the batch of ciphertexts, ciphertext i encrypting m[i]
+   */
+    LWECiphertextBatch EncryptBatch(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk,
+                                    const std::vector<LWEPlaintext>& m, LWEPlaintextModulus p = 4,
+                                    NativeInteger mod = 0) const;
+
+    /**
+   * Encrypts a batch of plaintexts using a public key (asymmetric key encryption). The ternary
+   * vectors s' of all ciphertexts are applied to the public matrix A block by block, so each
+   * row of A is read once per block of ciphertexts rather than once per ciphertext.
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param pk the public key
+   * @param m the plaintexts
+   * @param p the plaintext space
+   * @param mod the ciphertext modulus to encrypt with; must be the modulus of the public key
+   * @return the batch of ciphertexts of dimension N, ciphertext i encrypting m[i]
+   */
+    LWECiphertextBatch EncryptNBatch(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPublicKey& pk,
+                                     const std::vector<LWEPlaintext>& m, LWEPlaintextModulus p = 4,
+                                     NativeInteger mod = 0) const;
+
     /**
    * Converts a ciphertext (public key encryption) with modulus Q and dimension N to ciphertext with q and n
    *
@@ -123,6 +157,22 @@ public:
     LWECiphertext SwitchCTtoqn(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& ksk,
                                ConstLWECiphertext& ct) const;
 
+    /**
+   * Converts a ciphertext with modulus Q and dimension N to a ciphertext with q and n, writing
+   * the result into existing storage (e.g. a slot of an LWECiphertextBatch). The key-switched
+   * intermediate is kept in the storage of the result, so the only other memory needed is the
+   * caller-owned scratch, which can be reused across calls.
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param ksk the key switching key from secret key of dimension N to secret key of dimension n
+   * @param ct the ciphertext to convert
+   * @param result view of dimension n and modulus q receiving the converted ciphertext
+   * @param scratch holds the input switched to Q'; replaced by one ciphertext of dimension N
+   * modulo Q' unless it already has that shape
+   */
+    void SwitchCTtoqn(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& ksk,
+                      ConstLWECiphertextView ct, LWECiphertextView result, LWECiphertextBatch& scratch) const;
+
     /**
    * Decrypts the ciphertext using secret key sk
    *
@@ -135,6 +185,31 @@ public:
     void Decrypt(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk, ConstLWECiphertext& ct,
                  LWEPlaintext* result, LWEPlaintextModulus p = 4) const;
 
+    /**
+   * Decrypts the ciphertext referred to by a view using secret key sk
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param sk the secret key
+   * @param ct view of the ciphertext
+   * @param result plaintext result
+   * @param p the plaintext space
+   */
+    void Decrypt(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk, ConstLWECiphertextView ct,
+                 LWEPlaintext* result, LWEPlaintextModulus p = 4) const;
+
+    /**
+   * Decrypts a batch of ciphertexts using secret key sk; the secret key is prepared once
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param sk the secret key
+   * @param ct the batch of ciphertexts
+   * @param result plaintext results, resized to the number of ciphertexts
+   * @param p the plaintext space
+   */
+    void DecryptBatch(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk,
+                      const LWECiphertextBatch& ct, std::vector<LWEPlaintext>* result,
+                      LWEPlaintextModulus p = 4) const;
+
     /**
    * Adds the second ciphertext to the first ciphertext
    *
@@ -143,6 +218,14 @@ public:
    */
     void EvalAddEq(LWECiphertext& ct1, ConstLWECiphertext& ct2) const;
 
+    /**
+   * Adds the second ciphertext to the first ciphertext; both must have the same dimension and modulus
+   *
+   * @param ct1 view of the ciphertext which will hold the sum
+   * @param ct2 view of the ciphertext to add
+   */
+    void EvalAddEq(LWECiphertextView ct1, ConstLWECiphertextView ct2) const;
+
     /**
    * Adds the a constant to the ciphertext
    *
@@ -159,6 +242,14 @@ public:
    */
     void EvalSubEq(LWECiphertext& ct1, ConstLWECiphertext& ct2) const;
 
+    /**
+   * Subtracts the second ciphertext from the first ciphertext; both must have the same dimension and modulus
+   *
+   * @param ct1 view of the ciphertext which will hold the difference
+   * @param ct2 view of the ciphertext to subtract
+   */
+    void EvalSubEq(LWECiphertextView ct1, ConstLWECiphertextView ct2) const;
+
     /**
    * Subtracts the second ciphertext from the first ciphertext, the result is held in the first ciphertext
    *
@@ -192,6 +283,15 @@ public:
    */
     LWECiphertext ModSwitch(NativeInteger q, ConstLWECiphertext& ctQ) const;
 
+    /**
+   * Changes an LWE ciphertext modulo Q into an LWE ciphertext modulo q, where q is the modulus
+   * of the output view
+   *
+   * @param ctQ view of the input ciphertext
+   * @param ct view of the same dimension receiving the resulting ciphertext
+   */
+    void ModSwitch(ConstLWECiphertextView ctQ, LWECiphertextView ct) const;
+
     /**
    * Generates a switching key to go from a secret key with (Q,N) to a secret
    * key with (q,n)
@@ -215,6 +315,29 @@ public:
     LWECiphertext KeySwitch(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& K,
                             ConstLWECiphertext& ctQN) const;
 
+    /**
+   * Switches ciphertext from (Q,N) to (Q,n), writing the result into existing storage
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param K switching key
+   * @param ctQN view of the input ciphertext
+   * @param ct view of dimension n and modulus Q receiving the resulting ciphertext
+   */
+    void KeySwitch(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& K,
+                   ConstLWECiphertextView ctQN, LWECiphertextView ct) const;
+
+    /**
+   * Switches a batch of ciphertexts from (Q,N) to (Q,n). The ciphertexts are processed in
+   * blocks that share one pass over the switching key
+   *
+   * @param params a shared pointer to LWE scheme parameters
+   * @param K switching key
+   * @param ctQN the input ciphertexts
+   * @return the batch of resulting ciphertexts
+   */
+    LWECiphertextBatch KeySwitch(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& K,
+                                 const LWECiphertextBatch& ctQN) const;
+
     /**
    * Embeds a plaintext bit without noise or encryption
    *
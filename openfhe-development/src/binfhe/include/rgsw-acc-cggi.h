@@ -35,6 +35,7 @@
 #include "rgsw-acc.h"
 
 #include <memory>
+#include <vector>
 
 namespace lbcrypto {
 
@@ -68,6 +69,18 @@ public:
     void EvalAcc(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek, RLWECiphertext& acc,
                  const NativeVector& a) const override;
 
+    /**
+   * Accumulator function for several bootstrappings - GINX variant. The accumulators are
+   * updated in lockstep, so every key element is loaded once for all of them
+   *
+   * @param params a shared pointer to RingGSW scheme parameters
+   * @param ek the accumulator key
+   * @param acc previous values of the accumulators
+   * @param a values to update the accumulators with, one per accumulator
+   */
+    void EvalAccBatch(const std::shared_ptr<RingGSWCryptoParams>& params, ConstRingGSWACCKey& ek,
+                      std::vector<RLWECiphertext>& acc, const std::vector<NativeVector>& a) const override;
+
 private:
     /**
    * Key generation for internal Ring GSW as described in https://eprint.iacr.org/2020/086
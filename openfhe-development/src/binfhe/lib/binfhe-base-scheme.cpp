@@ -35,6 +35,15 @@
 
 namespace lbcrypto {
 
+// ct1 + ct2 as a new ciphertext with the plaintext modulus of ct1, computed in one pass instead of
+// copying ct1 and adding ct2 to the copy
+static LWECiphertext AddToNew(ConstLWECiphertext& ct1, ConstLWECiphertext& ct2) {
+    auto ct = std::make_shared<LWECiphertextImpl>(ct1->GetA().ModAdd(ct2->GetA()),
+                                                  ct1->GetB().ModAddFast(ct2->GetB(), ct1->GetModulus()));
+    ct->SetptModulus(ct1->GetptModulus());
+    return ct;
+}
+
 // wrapper for KeyGen methods
 RingGSWBTKey BinFHEScheme::KeyGen(const std::shared_ptr<BinFHECryptoParams>& params, ConstLWEPrivateKey& LWEsk,
                                   KEYGEN_MODE keygenMode = SYM_ENCRYPT) const {
@@ -76,6 +85,65 @@ RingGSWBTKey BinFHEScheme::KeyGen(const std::shared_ptr<BinFHECryptoParams>& par
 LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
                                         const RingGSWBTKey& EK, ConstLWECiphertext& ct1,
                                         ConstLWECiphertext& ct2, bool extended) const {
+    auto ct    = EvalBinGateInput(params, gate, EK, ct1, ct2);
+    auto ctExt = ExtractGateOutput(params, BootstrapGateCore(params, gate, EK.BSkey, ct));
+    if (extended)
+        return ctExt;
+    return LWEscheme->SwitchCTtoqn(params->GetLWEParams(), EK.KSkey, ctExt);
+}
+
+// Same as EvalBinGate for every gate; the accumulators of all gates are evaluated together, and
+// so is the final key switching
+std::vector<LWECiphertext> BinFHEScheme::EvalBinGateBatch(const std::shared_ptr<BinFHECryptoParams>& params,
+                                                          const std::vector<BINGATE>& gates, const RingGSWBTKey& EK,
+                                                          const std::vector<LWECiphertext>& ct1s,
+                                                          const std::vector<LWECiphertext>& ct2s,
+                                                          bool extended) const {
+    if (params == nullptr)
+        OPENFHE_THROW("BinFHECryptoParams is empty");
+    if (EK.BSkey == nullptr)
+        OPENFHE_THROW("Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.");
+    const size_t k = gates.size();
+    if (ct1s.size() != k || ct2s.size() != k)
+        OPENFHE_THROW("the numbers of gates and of input ciphertexts must match");
+
+    std::vector<RLWECiphertext> acc(k);
+    std::vector<NativeVector> a(k);
+    for (size_t i = 0; i < k; ++i) {
+        auto ct = EvalBinGateInput(params, gates[i], EK, ct1s[i], ct2s[i]);
+        acc[i]  = BootstrapGateInit(params, gates[i], ct);
+        a[i]    = ct->GetA();
+    }
+
+    // main accumulation computation for all gates
+    ACCscheme->EvalAccBatch(params->GetRingGSWParams(), EK.BSkey, acc, a);
+
+    std::vector<LWECiphertext> result(k);
+    for (size_t i = 0; i < k; ++i)
+        result[i] = ExtractGateOutput(params, acc[i]);
+    if (extended || k == 0)
+        return result;
+
+    // as in SwitchCTtoqn, with the key switching of all ciphertexts batched
+    const auto& LWEParams = params->GetLWEParams();
+    LWECiphertextBatch ctMS(k, LWEParams->GetN(), LWEParams->GetqKS());
+    for (size_t i = 0; i < k; ++i)
+        LWEscheme->ModSwitch(ConstLWECiphertextView(*result[i]), ctMS.View(i));
+    auto ctKS = LWEscheme->KeySwitch(LWEParams, EK.KSkey, ctMS);
+    for (size_t i = 0; i < k; ++i) {
+        auto ct = std::make_shared<LWECiphertextImpl>(NativeVector(LWEParams->Getn(), LWEParams->Getq()),
+                                                      NativeInteger(0));
+        LWEscheme->ModSwitch(ctKS.View(i), LWECiphertextView(*ct));
+        result[i] = ct;
+    }
+    return result;
+}
+
+// Combines the inputs of a two-input gate into the ciphertext to bootstrap, switching them to
+// (q, n) first if needed
+LWECiphertext BinFHEScheme::EvalBinGateInput(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                             const RingGSWBTKey& EK, ConstLWECiphertext& ct1,
+                                             ConstLWECiphertext& ct2) const {
     if (params == nullptr)
         OPENFHE_THROW("BinFHECryptoParams is empty");
     if (ct1 == nullptr)
@@ -89,40 +157,46 @@ LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams
     NativeInteger Q{LWEParams->GetQ()};
 
     // input cts expected with SMALL_DIM
-    auto cct1       = (Q == ct1->GetModulus()) ? LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ct1) : std::make_shared<LWECiphertextImpl>(*ct1);
     const auto cct2 = (Q == ct2->GetModulus()) ? LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ct2) : ct2;
 
-    // the additive homomorphic operation for XOR/NXOR is different from the other gates we compute
-    // 2*(ct1 + ct2) mod 4 for XOR, 0 -> 0, 2 -> 1
-    // XOR_FAST and XNOR_FAST are included for backwards compatibility; they map to XOR and XNOR
-    if ((gate == XOR) || (gate == XNOR) || (gate == XOR_FAST) || (gate == XNOR_FAST)) {
+    // for all gates we compute (ct1 + ct2) mod 4; a switched ct1 is a new ciphertext and takes the
+    // sum in place, otherwise the sum is written to a new ciphertext so that ct1 is never copied
+    // for AND: 0,1 -> 0 and 2,3 -> 1
+    // for OR: 1,2 -> 1 and 3,0 -> 0
+    LWECiphertext cct1;
+    if (Q == ct1->GetModulus()) {
+        cct1 = LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ct1);
         LWEscheme->EvalAddEq(cct1, cct2);
-        LWEscheme->EvalAddEq(cct1, cct1);
     }
     else {
-        // for all other gates, we simply compute (ct1 + ct2) mod 4
-        // for AND: 0,1 -> 0 and 2,3 -> 1
-        // for OR: 1,2 -> 1 and 3,0 -> 0
-        LWEscheme->EvalAddEq(cct1, cct2);
+        cct1 = AddToNew(ct1, cct2);
     }
 
+    // the additive homomorphic operation for XOR/NXOR is different from the other gates we compute
+    // 2*(ct1 + ct2) mod 4 for XOR, 0 -> 0, 2 -> 1
+    // XOR_FAST and XNOR_FAST are included for backwards compatibility; they map to XOR and XNOR
+    if ((gate == XOR) || (gate == XNOR) || (gate == XOR_FAST) || (gate == XNOR_FAST))
+        LWEscheme->EvalAddEq(cct1, cct1);
+    return cct1;
+}
+
+// Extracts the (N, Q) LWE ciphertext of a gate result from its accumulator
+LWECiphertext BinFHEScheme::ExtractGateOutput(const std::shared_ptr<BinFHECryptoParams>& params,
+                                              ConstRLWECiphertext& acc) const {
     // the accumulator result is encrypted w.r.t. the transposed secret key
     // we can transpose "a" to get an encryption under the original secret key
-    auto accVec{BootstrapGateCore(params, gate, EK.BSkey, cct1)->GetElements()};
+    auto accVec{acc->GetElements()};
     accVec[0] = accVec[0].Transpose();
     accVec[0].SetFormat(Format::COEFFICIENT);
     accVec[1].SetFormat(Format::COEFFICIENT);
 
     // hardcoded for p = 4
     // we add Q/8 to "b" to map back to Q/4 (i.e., mod 2) arithmetic.
+    NativeInteger Q{params->GetLWEParams()->GetQ()};
     NativeInteger b{(Q >> 3) + 1};
     b.ModAddFastEq(accVec[1][0], Q);
 
-    auto ctExt = std::make_shared<LWECiphertextImpl>(std::move(accVec[0].GetValues()), b);
-
-    if (extended)
-        return ctExt;
-    return LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ctExt);
+    return std::make_shared<LWECiphertextImpl>(std::move(accVec[0].GetValues()), b);
 }
 
 // Full evaluation as described in https://eprint.iacr.org/2020/086
@@ -147,10 +221,26 @@ LWECiphertext BinFHEScheme::EvalBinGate(const std::shared_ptr<BinFHECryptoParams
         NativeInteger Q{LWEParams->GetQ()};
 
         // input cts expected with SMALL_DIM
-        auto ct = (Q == ctvector[0]->GetModulus()) ? LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ctvector[0]) : std::make_shared<LWECiphertextImpl>(*ctvector[0]);
-        for (uint32_t i = 1; i < length; ++i) {
-            LWEscheme->EvalAddEq(ct, (Q == ctvector[i]->GetModulus()) ? LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ctvector[i]) : ctvector[i]);
+        auto input = [&](uint32_t i) -> ConstLWECiphertext {
+            return (Q == ctvector[i]->GetModulus()) ? LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ctvector[i]) :
+                                                      ctvector[i];
+        };
+        // the running sum starts in a new ciphertext (a switched input, or the sum of the first two)
+        // so that no input is copied
+        LWECiphertext ct;
+        uint32_t next = 1;
+        if (Q == ctvector[0]->GetModulus()) {
+            ct = LWEscheme->SwitchCTtoqn(LWEParams, EK.KSkey, ctvector[0]);
+        }
+        else if (length > 1) {
+            ct   = AddToNew(ctvector[0], input(1));
+            next = 2;
+        }
+        else {
+            ct = std::make_shared<LWECiphertextImpl>(*ctvector[0]);
         }
+        for (uint32_t i = next; i < length; ++i)
+            LWEscheme->EvalAddEq(ct, input(i));
 
         auto p = ctvector[0]->GetptModulus();
         ct->SetptModulus(p);
@@ -531,6 +621,16 @@ RLWECiphertext BinFHEScheme::BootstrapGateCore(const std::shared_ptr<BinFHECrypt
     if (ek == nullptr)
         OPENFHE_THROW("Bootstrapping keys have not been generated. Please call BTKeyGen before calling bootstrapping.");
 
+    // main accumulation computation
+    // the following loop is the bottleneck of bootstrapping/binary gate
+    // evaluation
+    auto acc = BootstrapGateInit(params, gate, ct);
+    ACCscheme->EvalAcc(params->GetRingGSWParams(), ek, acc, ct->GetA());
+    return acc;
+}
+
+RLWECiphertext BinFHEScheme::BootstrapGateInit(const std::shared_ptr<BinFHECryptoParams>& params, BINGATE gate,
+                                               ConstLWECiphertext& ct) const {
     // Specifies the range [lb, ub) that will be used for mapping
     NativeInteger q  = ct->GetModulus();
     auto qHalf       = q.ConvertToInt<uint32_t>() >> 1;
@@ -574,12 +674,7 @@ RLWECiphertext BinFHEScheme::BootstrapGateCore(const std::shared_ptr<BinFHECrypt
     res[1].SetValues(std::move(m), Format::COEFFICIENT);
     res[1].SetFormat(Format::EVALUATION);
 
-    // main accumulation computation
-    // the following loop is the bottleneck of bootstrapping/binary gate
-    // evaluation
-    auto acc = std::make_shared<RLWECiphertextImpl>(std::move(res));
-    ACCscheme->EvalAcc(RGSWParams, ek, acc, ct->GetA());
-    return acc;
+    return std::make_shared<RLWECiphertextImpl>(std::move(res));
 }
 
 // Functions below are for large-precision sign evaluation,
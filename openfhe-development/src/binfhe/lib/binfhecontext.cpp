@@ -245,6 +245,15 @@ LWECiphertext BinFHEContext::Encrypt(ConstLWEPublicKey& pk, LWEPlaintext m, BINF
     return ct;
 }
 
+LWECiphertextBatch BinFHEContext::EncryptBatch(ConstLWEPrivateKey& sk, const std::vector<LWEPlaintext>& m,
+                                               LWEPlaintextModulus p, const NativeInteger& mod) const {
+    if (sk == nullptr)
+        OPENFHE_THROW("PrivateKey is empty");
+
+    auto&& LWEParams = m_params->GetLWEParams();
+    return m_LWEscheme->EncryptBatch(LWEParams, sk, m, p, (mod == 0 ? LWEParams->Getq() : mod));
+}
+
 LWECiphertext BinFHEContext::SwitchCTtoqn(ConstLWESwitchingKey& ksk, ConstLWECiphertext& ct) const {
     if (ksk == nullptr)
         OPENFHE_THROW("SwitchingKey is empty");
@@ -267,6 +276,14 @@ void BinFHEContext::Decrypt(ConstLWEPrivateKey& sk, ConstLWECiphertext& ct, LWEP
     m_LWEscheme->Decrypt(m_params->GetLWEParams(), sk, ct, result, p);
 }
 
+void BinFHEContext::DecryptBatch(ConstLWEPrivateKey& sk, const LWECiphertextBatch& ct,
+                                 std::vector<LWEPlaintext>* result, LWEPlaintextModulus p) const {
+    if (sk == nullptr)
+        OPENFHE_THROW("PrivateKey is empty");
+
+    m_LWEscheme->DecryptBatch(m_params->GetLWEParams(), sk, ct, result, p);
+}
+
 LWESwitchingKey BinFHEContext::KeySwitchGen(ConstLWEPrivateKey& sk, ConstLWEPrivateKey& skN) const {
     if (sk == nullptr)
         OPENFHE_THROW("New PrivateKey is empty");
@@ -310,6 +327,13 @@ LWECiphertext BinFHEContext::EvalBinGate(const BINGATE gate, ConstLWECiphertext&
     return m_binfhescheme->EvalBinGate(m_params, gate, m_BTKey, ct1, ct2, extended);
 }
 
+std::vector<LWECiphertext> BinFHEContext::EvalBinGateBatch(const std::vector<BINGATE>& gates,
+                                                           const std::vector<LWECiphertext>& ct1s,
+                                                           const std::vector<LWECiphertext>& ct2s,
+                                                           bool extended) const {
+    return m_binfhescheme->EvalBinGateBatch(m_params, gates, m_BTKey, ct1s, ct2s, extended);
+}
+
 LWECiphertext BinFHEContext::EvalBinGate(const BINGATE gate, const std::vector<LWECiphertext>& ctvector, bool extended) const {
     return m_binfhescheme->EvalBinGate(m_params, gate, m_BTKey, ctvector, extended);
 }
@@ -34,8 +34,103 @@
 #include "math/binaryuniformgenerator.h"
 #include "math/discreteuniformgenerator.h"
 #include "math/ternaryuniformgenerator.h"
+#include "utils/parallel.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace lbcrypto {
+// number of ciphertexts that share one pass over the public matrix in EncryptNBatch
+constexpr uint32_t LWE_BATCH_BLOCK{16};
+
+// out[i] = <A_i, s> mod q for the rows A_i of the row-major count x n matrix A whose rows
+// start stride integers apart. s is the same for every row, so the Shoup precomputation for
+// each s_j is done once for the batch
+static void InnerProductsModq(const NativeInteger* A, uint32_t count, uint32_t stride, const NativeVector& s,
+                              const NativeInteger& mod, NativeInteger* out) {
+    const uint32_t n = s.GetLength();
+    std::vector<NativeInteger> sPrecon(n);
+    for (uint32_t j = 0; j < n; ++j)
+        sPrecon[j] = s[j].PrepModMulConst(mod);
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(count))
+    for (uint32_t i = 0; i < count; ++i) {
+        const NativeInteger* a = A + static_cast<size_t>(i) * stride;
+        NativeInteger inner(0);
+        for (uint32_t j = 0; j < n; ++j)
+            inner.ModAddFastEq(a[j].ModMulFastConst(s[j], mod, sPrecon[j]), mod);
+        out[i] = inner;
+    }
+}
+
+// Key switching of count ciphertexts in one pass over the key K, whose "a" tensor has entries
+// of type T. For every ciphertext the key rows selected by the base-B digits of its "a" part
+// are summed into accumulators of type Acc without reduction; since every entry is below q the
+// sums are reduced only when one more row could overflow them, and once at the end:
+// a = -sum mod q, b = b_QN - sum of the selected "b" parts mod q
+template <typename T, typename Acc>
+static void KeySwitchBlock(const LWESwitchingKeyImpl& K, const T* keyA, const ConstLWECiphertextView* ctQN,
+                           const LWECiphertextView* ct, uint32_t count) {
+    const uint32_t N      = K.GetN();
+    const uint32_t n      = K.Getn();
+    const uint32_t stride = K.GetStride();
+    const uint32_t digits = K.GetDigitCount();
+    const NativeInteger::Integer baseKS(K.GetBaseKS());
+    const NativeInteger& Q = K.GetModulus();
+    const auto q           = Q.ConvertToInt<Acc>();
+    // rows that can be added to a reduced accumulator
+    const size_t lazyRounds = std::max<size_t>(1, (std::numeric_limits<Acc>::max() - (q - 1)) / (q - 1));
+
+    std::vector<Acc, AlignedAllocator<Acc>> acc(static_cast<size_t>(count) * stride, 0);
+    std::vector<NativeInteger> b(count);
+    std::vector<NativeInteger::Integer> atmp(count);
+    for (uint32_t c = 0; c < count; ++c)
+        b[c] = ctQN[c].GetB();
+
+    size_t rounds = 0;
+    for (uint32_t i = 0; i < N; ++i) {
+        for (uint32_t c = 0; c < count; ++c)
+            atmp[c] = ctQN[c].GetA(i).ConvertToInt();
+        for (uint32_t j = 0; j < digits; ++j) {
+            if (rounds == lazyRounds) {
+                for (auto& x : acc)
+                    x %= q;
+                rounds = 0;
+            }
+            ++rounds;
+            for (uint32_t c = 0; c < count; ++c) {
+                const auto d = static_cast<uint32_t>(atmp[c] % baseKS);
+                atmp[c] /= baseKS;
+                const size_t index = K.GetIndex(i, j, d);
+                b[c].ModSubFastEq(K.GetElementsB()[index], Q);
+                const T* row = keyA + index * stride;
+                Acc* accc    = acc.data() + static_cast<size_t>(c) * stride;
+#pragma omp simd
+                for (uint32_t k = 0; k < n; ++k)
+                    accc[k] += row[k];
+            }
+        }
+    }
+
+    for (uint32_t c = 0; c < count; ++c) {
+        const Acc* accc = acc.data() + static_cast<size_t>(c) * stride;
+        for (uint32_t k = 0; k < n; ++k) {
+            const Acc r   = accc[k] % q;
+            ct[c].GetA(k) = NativeInteger(r == 0 ? 0 : q - r);
+        }
+        ct[c].GetB() = b[c];
+    }
+}
+
+// c * x mod q for c in {-1, 0, 1}, selecting x, q - x or 0 with masks rather than branching
+// on the secret c. For x = 0 and c = -1 this returns q, which ModAddFastEq reduces again
+static inline NativeInteger TernaryTerm(const NativeInteger& x, int32_t c, BasicInteger q) {
+    const BasicInteger pos = BasicInteger(0) - static_cast<BasicInteger>(c == 1);
+    const BasicInteger neg = BasicInteger(0) - static_cast<BasicInteger>(c == -1);
+    const BasicInteger v   = x.ConvertToInt<BasicInteger>();
+    return NativeInteger((v & pos) | ((q - v) & neg));
+}
+
 // the main rounding operation used in ModSwitch (as described in Section 3 of
 // https://eprint.iacr.org/2014/816) The idea is that Round(x) = 0.5 + Floor(x)
 NativeInteger LWEEncryptionScheme::RoundqQ(const NativeInteger& v, const NativeInteger& q,
@@ -166,32 +261,155 @@ LWECiphertext LWEEncryptionScheme::EncryptN(const std::shared_ptr<LWECryptoParam
     return ct;
 }
 
+// batched classical LWE encryption: A is a uniform count x n matrix and
+// b_i = <A_i, s> + e_i + m_i floor(q/p)
+LWECiphertextBatch LWEEncryptionScheme::EncryptBatch(const std::shared_ptr<LWECryptoParams>& params,
+                                                     ConstLWEPrivateKey& sk, const std::vector<LWEPlaintext>& m,
+                                                     LWEPlaintextModulus p, NativeInteger mod) const {
+    if (mod % p != 0 && mod.ConvertToInt() & (1 == 0)) {
+        std::string errMsg = "ERROR: ciphertext modulus q needs to be divisible by plaintext modulus p.";
+        OPENFHE_THROW(errMsg);
+    }
+
+    NativeVector s      = sk->GetElement();
+    const uint32_t n    = s.GetLength();
+    const uint32_t size = m.size();
+    s.SwitchModulus(mod);
+
+    LWECiphertextBatch ct(size, n, mod);
+    ct.SetptModulus(p);
+    if (size == 0)
+        return ct;
+
+    // one draw for the whole batch, spread over the padded rows
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector A = dug.GenerateVector(size * n, mod);
+    for (uint32_t i = 0; i < size; ++i)
+        std::copy_n(&A[static_cast<size_t>(i) * n], n, ct.GetA(i));
+    NativeVector e = params->GetDgg().GenerateVector(size, mod);
+
+    std::vector<NativeInteger> inner(size);
+    InnerProductsModq(ct.GetA(0), size, ct.GetStride(), s, mod, inner.data());
+
+    const NativeInteger delta = mod / p;
+    for (uint32_t i = 0; i < size; ++i) {
+        NativeInteger& b = ct.GetB(i);
+        b                = e[i];
+        b.ModAddFastEq(NativeInteger(m[i] % p) * delta, mod);
+        b.ModAddFastEq(inner[i], mod);
+    }
+    return ct;
+}
+
+// batched public key LWE encryption: for every ciphertext i with ternary s'_i
+// a_i = A s'_i + e'_i and b_i = v s'_i + e"_i + m_i floor(q/p). The rows of A are
+// applied to LWE_BATCH_BLOCK ciphertexts at a time, so A is read once per block
+LWECiphertextBatch LWEEncryptionScheme::EncryptNBatch(const std::shared_ptr<LWECryptoParams>& params,
+                                                      ConstLWEPublicKey& pk, const std::vector<LWEPlaintext>& m,
+                                                      LWEPlaintextModulus p, NativeInteger mod) const {
+    if (mod % p != 0 && mod.ConvertToInt() & (1 == 0)) {
+        std::string errMsg = "ERROR: ciphertext modulus q needs to be divisible by plaintext modulus p.";
+        OPENFHE_THROW(errMsg);
+    }
+
+    const auto& v = pk->Getv();
+    const auto& A = pk->GetA();
+    if (mod != v.GetModulus())
+        OPENFHE_THROW("ciphertext modulus must be the modulus of the public key");
+
+    const uint32_t N    = v.GetLength();
+    const uint32_t size = m.size();
+
+    TernaryUniformGeneratorImpl<NativeVector> tug;
+    const std::shared_ptr<int32_t> spAll = tug.GenerateIntVector(size * N);
+    const int32_t* sp                    = spAll.get();
+
+    LWECiphertextBatch ct(size, N, mod);
+    ct.SetptModulus(p);
+    if (size == 0)
+        return ct;
+
+    const auto& dgg = params->GetDgg();
+    NativeVector e1 = dgg.GenerateVector(size * N, mod);
+    NativeVector e2 = dgg.GenerateVector(size, mod);
+    for (uint32_t l = 0; l < size; ++l) {
+        std::copy_n(&e1[static_cast<size_t>(l) * N], N, ct.GetA(l));
+        ct.GetB(l) = e2[l];
+    }
+    const auto delta = mod / p;
+    const auto q     = mod.ConvertToInt<BasicInteger>();
+
+    const uint32_t blocks = (size + LWE_BATCH_BLOCK - 1) / LWE_BATCH_BLOCK;
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(blocks))
+    for (uint32_t block = 0; block < blocks; ++block) {
+        const uint32_t lb   = block * LWE_BATCH_BLOCK;
+        const uint32_t lEnd = std::min(lb + LWE_BATCH_BLOCK, size);
+        for (uint32_t j = 0; j < N; ++j) {
+            // columnwise a_l = A_1 s'_l1 + ... + A_N s'_lN
+            const auto& Aj = A[j];
+            for (uint32_t l = lb; l < lEnd; ++l) {
+                const int32_t c   = sp[static_cast<size_t>(l) * N + j];
+                NativeInteger* al = ct.GetA(l);
+                for (uint32_t k = 0; k < N; ++k)
+                    al[k].ModAddFastEq(TernaryTerm(Aj[k], c, q), mod);
+            }
+        }
+        for (uint32_t l = lb; l < lEnd; ++l) {
+            const int32_t* spl = &sp[static_cast<size_t>(l) * N];
+            NativeInteger& bl  = ct.GetB(l);
+            bl.ModAddFastEq(NativeInteger(m[l] % p) * delta, mod);
+            for (uint32_t j = 0; j < N; ++j)
+                bl.ModAddFastEq(TernaryTerm(v[j], spl[j], q), mod);
+        }
+    }
+    return ct;
+}
+
 // convert ciphertext with modulus Q and dimension N to ciphertext with modulus q and dimension n
 LWECiphertext LWEEncryptionScheme::SwitchCTtoqn(const std::shared_ptr<LWECryptoParams>& params,
                                                 ConstLWESwitchingKey& ksk, ConstLWECiphertext& ct) const {
+    auto result = std::make_shared<LWECiphertextImpl>(NativeVector(params->Getn(), params->Getq()), NativeInteger(0));
+    LWECiphertextBatch scratch;
+    SwitchCTtoqn(params, ksk, ConstLWECiphertextView(*ct), LWECiphertextView(*result), scratch);
+    return result;
+}
+
+void LWEEncryptionScheme::SwitchCTtoqn(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& ksk,
+                                       ConstLWECiphertextView ct, LWECiphertextView result,
+                                       LWECiphertextBatch& scratch) const {
+    const NativeInteger qKS(params->GetqKS());
+    if (scratch.GetCount() < 1 || scratch.GetLength() != ct.GetLength() || scratch.GetModulus() != qKS)
+        scratch = LWECiphertextBatch(1, ct.GetLength(), qKS);
     // Modulus switching to a middle step Q'
-    auto ctMS = ModSwitch(params->GetqKS(), ct);
-    // Key switching
-    auto ctKS = KeySwitch(params, ksk, ctMS);
+    ModSwitch(ct, scratch.View(0));
+    // Key switching; the result modulo Q' is written into the storage of the output and
+    // switched to q in place
+    LWECiphertextView ctKS(result.GetA(), &result.GetB(), result.GetLength(), qKS);
+    KeySwitch(params, ksk, scratch.View(0), ctKS);
     // Modulus switching
-    return ModSwitch(params->Getq(), ctKS);
+    ModSwitch(ctKS, result);
 }
 
 // classical LWE decryption
 // m_result = Round(4/q * (b - a*s))
 void LWEEncryptionScheme::Decrypt(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk,
                                   ConstLWECiphertext& ct, LWEPlaintext* result, LWEPlaintextModulus p) const {
+    Decrypt(params, sk, ConstLWECiphertextView(*ct), result, p);
+}
+
+void LWEEncryptionScheme::Decrypt(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk,
+                                  ConstLWECiphertextView ct, LWEPlaintext* result, LWEPlaintextModulus p) const {
     // TODO in the future we should add a check to make sure sk parameters match
     // the ct parameters
 
     // Create local variables to speed up the computations
-    const auto& mod = ct->GetModulus();
+    const auto& mod = ct.GetModulus();
     if (mod % (p * 2) != 0 && mod.ConvertToInt() & (1 == 0)) {
         std::string errMsg = "ERROR: ciphertext modulus q needs to be divisible by plaintext modulus p*2.";
         OPENFHE_THROW(errMsg);
     }
 
-    const auto& a = ct->GetA();
+    const auto* a = ct.GetA();
     auto s        = sk->GetElement();
     uint32_t n    = s.GetLength();
     auto mu       = mod.ComputeMu();
@@ -202,7 +420,7 @@ void LWEEncryptionScheme::Decrypt(const std::shared_ptr<LWECryptoParams>& params
     }
     inner.ModEq(mod);
 
-    NativeInteger r = ct->GetB();
+    NativeInteger r = ct.GetB();
 
     r.ModSubFastEq(inner, mod);
 
@@ -222,11 +440,52 @@ void LWEEncryptionScheme::Decrypt(const std::shared_ptr<LWECryptoParams>& params
 #endif
 }
 
+// batched classical LWE decryption: the inner products <a_i, s> of all ciphertexts form
+// one matrix-vector product, then every result is rounded as in Decrypt
+void LWEEncryptionScheme::DecryptBatch(const std::shared_ptr<LWECryptoParams>& params, ConstLWEPrivateKey& sk,
+                                       const LWECiphertextBatch& ct, std::vector<LWEPlaintext>* result,
+                                       LWEPlaintextModulus p) const {
+    const auto& mod = ct.GetModulus();
+    if (mod % (p * 2) != 0 && mod.ConvertToInt() & (1 == 0)) {
+        std::string errMsg = "ERROR: ciphertext modulus q needs to be divisible by plaintext modulus p*2.";
+        OPENFHE_THROW(errMsg);
+    }
+
+    auto s = sk->GetElement();
+    if (s.GetLength() != ct.GetLength())
+        OPENFHE_THROW("secret key and ciphertext dimensions do not match");
+    s.SwitchModulus(mod);
+
+    const uint32_t size = ct.GetCount();
+    std::vector<NativeInteger> inner(size);
+    if (size > 0)
+        InnerProductsModq(ct.GetA(0), size, ct.GetStride(), s, mod, inner.data());
+
+    result->resize(size);
+    const NativeInteger half = mod / (p * 2);
+    for (uint32_t i = 0; i < size; ++i) {
+        NativeInteger r = ct.GetB(i);
+        r.ModSubFastEq(inner[i], mod);
+        // Round(p/q x) = Floor(p/q (x + q/(2p))), as in Decrypt
+        r.ModAddFastEq(half, mod);
+        (*result)[i] = ((NativeInteger(p) * r) / mod).ConvertToInt();
+    }
+}
+
 void LWEEncryptionScheme::EvalAddEq(LWECiphertext& ct1, ConstLWECiphertext& ct2) const {
     ct1->GetA().ModAddEq(ct2->GetA());
     ct1->GetB().ModAddFastEq(ct2->GetB(), ct1->GetModulus());
 }
 
+void LWEEncryptionScheme::EvalAddEq(LWECiphertextView ct1, ConstLWECiphertextView ct2) const {
+    const auto& mod         = ct1.GetModulus();
+    NativeInteger* a1       = ct1.GetA();
+    const NativeInteger* a2 = ct2.GetA();
+    for (uint32_t i = 0; i < ct1.GetLength(); ++i)
+        a1[i].ModAddFastEq(a2[i], mod);
+    ct1.GetB().ModAddFastEq(ct2.GetB(), mod);
+}
+
 void LWEEncryptionScheme::EvalAddConstEq(LWECiphertext& ct, NativeInteger cnst) const {
     ct->GetB().ModAddFastEq(cnst, ct->GetModulus());
 }
@@ -236,6 +495,15 @@ void LWEEncryptionScheme::EvalSubEq(LWECiphertext& ct1, ConstLWECiphertext& ct2)
     ct1->GetB().ModSubFastEq(ct2->GetB(), ct1->GetModulus());
 }
 
+void LWEEncryptionScheme::EvalSubEq(LWECiphertextView ct1, ConstLWECiphertextView ct2) const {
+    const auto& mod         = ct1.GetModulus();
+    NativeInteger* a1       = ct1.GetA();
+    const NativeInteger* a2 = ct2.GetA();
+    for (uint32_t i = 0; i < ct1.GetLength(); ++i)
+        a1[i].ModSubFastEq(a2[i], mod);
+    ct1.GetB().ModSubFastEq(ct2.GetB(), mod);
+}
+
 void LWEEncryptionScheme::EvalSubEq2(ConstLWECiphertext& ct1, LWECiphertext& ct2) const {
     ct2->GetA() = ct1->GetA().ModSub(ct2->GetA());
     ct2->GetB() = ct1->GetB().ModSubFast(ct2->GetB(), ct1->GetModulus());
@@ -252,12 +520,18 @@ void LWEEncryptionScheme::EvalMultConstEq(LWECiphertext& ct1, NativeInteger cnst
 
 // Modulus switching - directly applies the scale-and-round operation RoundQ
 LWECiphertext LWEEncryptionScheme::ModSwitch(NativeInteger q, ConstLWECiphertext& ctQ) const {
-    auto n = ctQ->GetLength();
-    auto Q = ctQ->GetModulus();
-    NativeVector a(n, q);
+    auto ct = std::make_shared<LWECiphertextImpl>(NativeVector(ctQ->GetLength(), q), NativeInteger(0));
+    ModSwitch(ConstLWECiphertextView(*ctQ), LWECiphertextView(*ct));
+    return ct;
+}
+
+void LWEEncryptionScheme::ModSwitch(ConstLWECiphertextView ctQ, LWECiphertextView ct) const {
+    const auto n  = ctQ.GetLength();
+    const auto& Q = ctQ.GetModulus();
+    const auto& q = ct.GetModulus();
     for (uint32_t i = 0; i < n; ++i)
-        a[i] = RoundqQ(ctQ->GetA()[i], q, Q);
-    return std::make_shared<LWECiphertextImpl>(std::move(a), RoundqQ(ctQ->GetB(), q, Q));
+        ct.GetA(i) = RoundqQ(ctQ.GetA(i), q, Q);
+    ct.GetB() = RoundqQ(ctQ.GetB(), q, Q);
 }
 
 // Switching key as described in Section 3 of https://eprint.iacr.org/2014/816
@@ -294,81 +568,86 @@ LWESwitchingKey LWEEncryptionScheme::KeySwitchGen(const std::shared_ptr<LWECrypt
     //        }
     //    }
 
-    DiscreteUniformGeneratorImpl<NativeVector> dug(qKS);
-
-    NativeInteger mu(qKS.ComputeMu());
+    // the Shoup precomputation for s is shared by all samples
+    std::vector<NativeInteger> svPrecon(n);
+    for (size_t t = 0; t < n; ++t)
+        svPrecon[t] = sv[t].PrepModMulConst(qKS);
 
-    std::vector<std::vector<std::vector<NativeVector>>> resultVecA(N);
-    std::vector<std::vector<std::vector<NativeInteger>>> resultVecB(N);
+    auto K              = std::make_shared<LWESwitchingKeyImpl>(N, baseKS, digitCount, n, qKS);
+    const auto& dggKS   = params->GetDggKS();
+    const uint32_t rows = baseKS * digitCount;
 
-    // TODO (cpascoe/dsuponit): this pragma needs to be revised as it may have to be removed completely
-    // #if !defined(__MINGW32__) && !defined(__MINGW64__)
-    // #pragma omp parallel for num_threads(N)
-    // #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(N))
-    // #endif
+    // the samples for every i are drawn in bulk; PseudoRandomNumberGenerator::GetPRNG() is
+    // thread-private, so every thread draws from its own PRNG stream
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(N))
     for (size_t i = 0; i < N; ++i) {
-        std::vector<std::vector<NativeVector>> vector1A;
-        vector1A.reserve(baseKS);
-        std::vector<std::vector<NativeInteger>> vector1B;
-        vector1B.reserve(baseKS);
-
-        for (size_t j = 0; j < baseKS; ++j) {
-            std::vector<NativeVector> vector2A;
-            vector2A.reserve(digitCount);
-            std::vector<NativeInteger> vector2B;
-            vector2B.reserve(digitCount);
-            for (size_t k = 0; k < digitCount; ++k) {
-                vector2A.emplace_back(dug.GenerateVector(n));
-                NativeVector& a = vector2A.back();
-                NativeInteger b =
-                    (params->GetDggKS().GenerateInteger(qKS)).ModAdd(svN[i].ModMul(j * digitsKS[k], qKS), qKS);
-#if NATIVEINT == 32
-                for (size_t i = 0; i < n; ++i) {
-                    b.ModAddFastEq(a[i].ModMulFast(sv[i], qKS, mu), qKS);
-                }
-#else
-                for (size_t i = 0; i < n; ++i) {
-                    b += a[i].ModMulFast(sv[i], qKS, mu);
-                }
-                b.ModEq(qKS);
-#endif
-                vector2B.emplace_back(b);
+        DiscreteUniformGeneratorImpl<NativeVector> dug;
+        const NativeVector a = dug.GenerateVector(rows * n, qKS);
+        const NativeVector e = dggKS.GenerateVector(rows, qKS);
+        for (size_t k = 0; k < digitCount; ++k) {
+            for (size_t j = 0; j < baseKS; ++j) {
+                const size_t r          = k * baseKS + j;
+                const NativeInteger* ar = &a[r * n];
+                NativeInteger b         = e[r].ModAdd(svN[i].ModMul(j * digitsKS[k], qKS), qKS);
+                for (size_t t = 0; t < n; ++t)
+                    b.ModAddFastEq(ar[t].ModMulFastConst(sv[t], qKS, svPrecon[t]), qKS);
+                K->SetElementA(i, k, j, ar);
+                K->SetElementB(i, k, j, b);
             }
-            vector1A.push_back(std::move(vector2A));
-            vector1B.push_back(std::move(vector2B));
         }
-        resultVecA[i] = std::move(vector1A);
-        resultVecB[i] = std::move(vector1B);
     }
-    return std::make_shared<LWESwitchingKeyImpl>(std::move(resultVecA), std::move(resultVecB));
+    return K;
 }
 
 // the key switching operation as described in Section 3 of
 // https://eprint.iacr.org/2014/816
 LWECiphertext LWEEncryptionScheme::KeySwitch(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& K,
                                              ConstLWECiphertext& ctQN) const {
-    const size_t n(params->Getn());
-    const size_t N(params->GetN());
     NativeInteger Q(params->GetqKS());
-    NativeInteger::Integer baseKS(params->GetBaseKS());
-    const auto digitCount = static_cast<size_t>(std::ceil(log(Q.ConvertToDouble()) / log(static_cast<double>(baseKS))));
+    auto ct = std::make_shared<LWECiphertextImpl>(NativeVector(params->Getn(), Q), NativeInteger(0));
+    KeySwitch(params, K, ConstLWECiphertextView(*ctQN), LWECiphertextView(*ct));
+    return ct;
+}
 
-    NativeVector a(n, Q);
-    NativeInteger b(ctQN->GetB());
-    for (size_t i = 0; i < N; ++i) {
-        auto& refA = K->GetElementsA()[i];
-        auto& refB = K->GetElementsB()[i];
-        NativeInteger::Integer atmp(ctQN->GetA(i).ConvertToInt());
-        for (size_t j = 0; j < digitCount; ++j) {
-            const auto a0 = (atmp % baseKS);
-            atmp /= baseKS;
-            b.ModSubFastEq(refB[a0][j], Q);
-            auto& refAj = refA[a0][j];
-            for (size_t k = 0; k < n; ++k)
-                a[k].ModSubFastEq(refAj[k], Q);
+// ctQN and ct must not overlap
+void LWEEncryptionScheme::KeySwitch(const std::shared_ptr<LWECryptoParams>& params, ConstLWESwitchingKey& K,
+                                    ConstLWECiphertextView ctQN, LWECiphertextView ct) const {
+    if (K->IsCompact())
+        KeySwitchBlock<uint16_t, uint32_t>(*K, K->GetCompactA().data(), &ctQN, &ct, 1);
+    else
+        KeySwitchBlock<NativeInteger::Integer, NativeInteger::Integer>(*K, K->GetWideA().data(), &ctQN, &ct, 1);
+}
+
+// the ciphertexts are switched LWE_BATCH_BLOCK at a time, so the key is read once per block
+LWECiphertextBatch LWEEncryptionScheme::KeySwitch(const std::shared_ptr<LWECryptoParams>& params,
+                                                  ConstLWESwitchingKey& K, const LWECiphertextBatch& ctQN) const {
+    if (ctQN.GetLength() != K->GetN() || ctQN.GetModulus() != K->GetModulus())
+        OPENFHE_THROW("ciphertext dimension or modulus does not match the switching key");
+
+    const uint32_t size = ctQN.GetCount();
+    LWECiphertextBatch ct(size, K->Getn(), K->GetModulus());
+    ct.SetptModulus(ctQN.GetptModulus());
+
+    const uint32_t blocks = (size + LWE_BATCH_BLOCK - 1) / LWE_BATCH_BLOCK;
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(blocks))
+    for (uint32_t block = 0; block < blocks; ++block) {
+        const uint32_t lb    = block * LWE_BATCH_BLOCK;
+        const uint32_t count = std::min(LWE_BATCH_BLOCK, size - lb);
+        std::vector<ConstLWECiphertextView> in;
+        std::vector<LWECiphertextView> out;
+        in.reserve(count);
+        out.reserve(count);
+        for (uint32_t l = lb; l < lb + count; ++l) {
+            in.push_back(ctQN.View(l));
+            out.push_back(ct.View(l));
         }
+        if (K->IsCompact())
+            KeySwitchBlock<uint16_t, uint32_t>(*K, K->GetCompactA().data(), in.data(), out.data(), count);
+        else
+            KeySwitchBlock<NativeInteger::Integer, NativeInteger::Integer>(*K, K->GetWideA().data(), in.data(),
+                                                                           out.data(), count);
     }
-    return std::make_shared<LWECiphertextImpl>(std::move(a), b);
+    return ct;
 }
 
 // noiseless LWE embedding
@@ -67,6 +67,35 @@ void RingGSWAccumulatorCGGI::EvalAcc(const std::shared_ptr<RingGSWCryptoParams>&
     }
 }
 
+void RingGSWAccumulatorCGGI::EvalAccBatch(const std::shared_ptr<RingGSWCryptoParams>& params,
+                                          ConstRingGSWACCKey& ek, std::vector<RLWECiphertext>& acc,
+                                          const std::vector<NativeVector>& a) const {
+    const size_t k{acc.size()};
+    if (k == 0)
+        return;
+    if (a.size() != k)
+        OPENFHE_THROW("the number of accumulators and of input vectors must match");
+    size_t n{a[0].GetLength()};
+    auto mod{a[0].GetModulus()};
+    for (size_t j = 1; j < k; ++j) {
+        if (a[j].GetLength() != n || a[j].GetModulus() != mod)
+            OPENFHE_THROW("all input vectors must have the same length and modulus");
+    }
+    auto MbyMod{NativeInteger(2 * params->GetN()) / mod};
+    // one parallel region for the whole accumulation. The static schedule gives every thread the
+    // same accumulators for each i, so acc[j] is updated in order by one thread and the loops need
+    // no barrier between them
+#pragma omp parallel num_threads(OpenFHEParallelControls.GetThreadLimit(k))
+    for (size_t i = 0; i < n; ++i) {
+        // the key elements for s_i stay in cache while they are applied to every accumulator
+        const auto& ek0 = (*ek)[0][0][i];
+        const auto& ek1 = (*ek)[0][1][i];
+#pragma omp for schedule(static) nowait
+        for (size_t j = 0; j < k; ++j)
+            AddToAccCGGI(params, ek0, ek1, NativeInteger(0).ModSubFast(a[j][i], mod) * MbyMod, acc[j]);
+    }
+}
+
 // Encryption for the CGGI variant, as described in https://eprint.iacr.org/2020/086
 RingGSWEvalKey RingGSWAccumulatorCGGI::KeyGenCGGI(const std::shared_ptr<RingGSWCryptoParams>& params,
                                                   const NativePoly& skNTT, LWEPlaintext m) const {
@@ -612,3 +612,190 @@ TEST(UNITTestFHEWPKEGINX, XNOR) {
     EXPECT_EQ(0, result10) << failed;
     EXPECT_EQ(1, result00) << failed;
 }
+
+// Checks batched encryption and decryption against the single-ciphertext API
+TEST(UNITTestFHEWBatch, EncryptDecrypt) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+
+    auto sk = cc.KeyGen();
+
+    std::vector<LWEPlaintext> m(100);
+    for (size_t i = 0; i < m.size(); ++i)
+        m[i] = (3 * i + 1) % 4;
+
+    auto ct = cc.EncryptBatch(sk, m);
+    EXPECT_EQ(m.size(), ct.GetCount());
+    EXPECT_EQ(cc.GetParams()->GetLWEParams()->Getn(), ct.GetLength());
+
+    std::vector<LWEPlaintext> result;
+    cc.DecryptBatch(sk, ct, &result);
+    EXPECT_EQ(m, result) << "DecryptBatch failed";
+
+    for (uint32_t i = 0; i < ct.GetCount(); ++i) {
+        LWEPlaintext single;
+        cc.Decrypt(sk, ct.Get(i), &single);
+        EXPECT_EQ(m[i], single) << "Decrypt of a batch entry failed";
+    }
+
+    // a ciphertext from the single API can be stored in a batch
+    ct.Set(0, cc.Encrypt(sk, 2));
+    cc.DecryptBatch(sk, ct, &result);
+    EXPECT_EQ(2, result[0]) << "Set failed";
+
+    cc.DecryptBatch(sk, cc.EncryptBatch(sk, {}), &result);
+    EXPECT_TRUE(result.empty());
+}
+
+// Checks batched public key encryption with ciphertexts of dimension N
+TEST(UNITTestFHEWBatch, EncryptNDecrypt) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+
+    auto skN    = cc.KeyGenN();
+    auto pk     = cc.PubKeyGen(skN);
+    auto params = cc.GetParams()->GetLWEParams();
+    auto scheme = cc.GetLWEScheme();
+
+    std::vector<LWEPlaintext> m(40);
+    for (size_t i = 0; i < m.size(); ++i)
+        m[i] = i % 2;
+
+    auto ct = scheme->EncryptNBatch(params, pk, m, 4, params->GetQ());
+    EXPECT_EQ(params->GetN(), ct.GetLength());
+
+    std::vector<LWEPlaintext> result;
+    scheme->DecryptBatch(params, skN, ct, &result);
+    EXPECT_EQ(m, result) << "EncryptNBatch failed";
+
+    LWEPlaintext single;
+    scheme->Decrypt(params, skN, ct.Get(3), &single);
+    EXPECT_EQ(m[3], single) << "Decrypt of a batch entry failed";
+}
+
+// Checks the view-based operations on ciphertexts stored in batches
+TEST(UNITTestFHEWBatch, ViewOps) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+
+    auto sk     = cc.KeyGen();
+    auto skN    = cc.KeyGenN();
+    auto pk     = cc.PubKeyGen(skN);
+    auto ksk    = cc.KeySwitchGen(sk, skN);
+    auto params = cc.GetParams()->GetLWEParams();
+    auto scheme = cc.GetLWEScheme();
+
+    std::vector<LWEPlaintext> m(8);
+    for (size_t i = 0; i < m.size(); ++i)
+        m[i] = (i / 2) % 2;
+
+    auto ctN = scheme->EncryptNBatch(params, pk, m, 4, params->GetQ());
+    LWECiphertextBatch ct(m.size(), params->Getn(), params->Getq());
+    LWECiphertextBatch scratch;
+    for (uint32_t i = 0; i < ct.GetCount(); ++i)
+        scheme->SwitchCTtoqn(params, ksk, ctN.View(i), ct.View(i), scratch);
+
+    std::vector<LWEPlaintext> result;
+    scheme->DecryptBatch(params, sk, ct, &result);
+    EXPECT_EQ(m, result) << "SwitchCTtoqn on views failed";
+
+    auto single = scheme->SwitchCTtoqn(params, ksk, ctN.Get(5));
+    EXPECT_EQ(single->GetA(), ct.Get(5)->GetA()) << "SwitchCTtoqn on views differs from the single API";
+    EXPECT_EQ(single->GetB(), ct.Get(5)->GetB()) << "SwitchCTtoqn on views differs from the single API";
+
+    auto sum = ct.Get(2);
+    scheme->EvalAddEq(sum, ct.Get(4));
+    scheme->EvalAddEq(ct.View(2), ct.View(4));
+    EXPECT_EQ(sum->GetA(), ct.Get(2)->GetA()) << "EvalAddEq on views differs from the single API";
+    EXPECT_EQ(sum->GetB(), ct.Get(2)->GetB()) << "EvalAddEq on views differs from the single API";
+
+    LWEPlaintext r;
+    scheme->Decrypt(params, sk, ct.View(2), &r);
+    EXPECT_EQ(m[2] + m[4], r) << "EvalAddEq on views failed";
+
+    scheme->EvalSubEq(ct.View(2), ct.View(4));
+    scheme->Decrypt(params, sk, ct.View(2), &r);
+    EXPECT_EQ(m[2], r) << "EvalSubEq on views failed";
+}
+
+// Checks batched key switching for keys stored with 16-bit and with full-width entries
+TEST(UNITTestFHEWBatch, KeySwitch) {
+    LWEEncryptionScheme scheme;
+    for (auto qKS : {NativeInteger(1 << 14), NativeInteger(1 << 20)}) {
+        auto params = std::make_shared<LWECryptoParams>(64, 512, 512, NativeInteger(1 << 27), qKS, 3.19, 32);
+
+        auto sk  = scheme.KeyGen(params->Getn(), qKS);
+        auto skN = scheme.KeyGen(params->GetN(), qKS);
+        auto K   = scheme.KeySwitchGen(params, sk, skN);
+        EXPECT_EQ(qKS <= NativeInteger(1 << 16), K->IsCompact());
+
+        std::vector<LWEPlaintext> m(20);
+        LWECiphertextBatch ctN(m.size(), params->GetN(), qKS);
+        for (uint32_t i = 0; i < m.size(); ++i) {
+            m[i] = i % 4;
+            ctN.Set(i, scheme.Encrypt(params, skN, m[i], 4, qKS));
+        }
+
+        auto ct = scheme.KeySwitch(params, K, ctN);
+        EXPECT_EQ(params->Getn(), ct.GetLength());
+
+        std::vector<LWEPlaintext> result;
+        scheme.DecryptBatch(params, sk, ct, &result);
+        EXPECT_EQ(m, result) << "batched KeySwitch failed";
+
+        auto single = scheme.KeySwitch(params, K, ctN.Get(3));
+        EXPECT_EQ(single->GetA(), ct.Get(3)->GetA()) << "batched KeySwitch differs from the single API";
+        EXPECT_EQ(single->GetB(), ct.Get(3)->GetB()) << "batched KeySwitch differs from the single API";
+    }
+}
+
+// Checks batched gate evaluation for the lockstep (GINX) and the default (AP) accumulators
+TEST(UNITTestFHEWBatch, EvalBinGateBatch) {
+    for (auto method : {GINX, AP}) {
+        auto cc = BinFHEContext();
+        cc.GenerateBinFHEContext(TOY, method);
+
+        auto sk = cc.KeyGen();
+        cc.BTKeyGen(sk);
+
+        std::vector<BINGATE> gates;
+        std::vector<LWECiphertext> ct1s, ct2s;
+        std::vector<LWEPlaintext> expected;
+        for (auto gate : {AND, OR, NAND, NOR, XOR, XNOR}) {
+            for (LWEPlaintext x : {0, 1}) {
+                for (LWEPlaintext y : {0, 1}) {
+                    gates.push_back(gate);
+                    ct1s.push_back(cc.Encrypt(sk, x));
+                    ct2s.push_back(cc.Encrypt(sk, y));
+                    LWEPlaintext r = (gate == AND || gate == NAND) ? (x & y) :
+                                     (gate == OR || gate == NOR)   ? (x | y) :
+                                                                     (x ^ y);
+                    expected.push_back((gate == NAND || gate == NOR || gate == XNOR) ? 1 - r : r);
+                }
+            }
+        }
+
+        auto ct = cc.EvalBinGateBatch(gates, ct1s, ct2s);
+        ASSERT_EQ(gates.size(), ct.size());
+        for (size_t i = 0; i < ct.size(); ++i) {
+            LWEPlaintext result;
+            cc.Decrypt(sk, ct[i], &result);
+            EXPECT_EQ(expected[i], result) << "EvalBinGateBatch failed for gate " << i;
+        }
+
+        EXPECT_TRUE(cc.EvalBinGateBatch({}, {}, {}).empty());
+        EXPECT_ANY_THROW(cc.EvalBinGateBatch({AND}, {ct1s[0]}, {}));
+    }
+}
+
+// Both the lockstep (CGGI) and the default (DM) EvalAccBatch reject mismatched inputs
+TEST(UNITTestFHEWBatch, EvalAccBatchSizes) {
+    auto cc = BinFHEContext();
+    cc.GenerateBinFHEContext(TOY, GINX);
+    auto params = cc.GetParams()->GetRingGSWParams();
+
+    std::vector<RLWECiphertext> acc(2);
+    std::vector<NativeVector> a(1);
+    EXPECT_THROW(RingGSWAccumulatorCGGI().EvalAccBatch(params, nullptr, acc, a), OpenFHEException);
+    EXPECT_THROW(RingGSWAccumulatorDM().EvalAccBatch(params, nullptr, acc, a), OpenFHEException);
+}
@@ -144,3 +144,67 @@ TEST(UnitTestFHEWPKESerialGINX, BINARY) {
     std::string msg = "UnitTestFHEWSerialGINX.BINARY serialization test failed: ";
     UnitTestFHEWPKESerial(SerType::BINARY, TOY, GINX, msg);
 }
+
+// A small switching key with pseudorandom entries below qKS
+static LWESwitchingKey MakeSwitchingKey(const NativeInteger& qKS) {
+    const uint32_t N = 8, baseKS = 4, digitCount = 3, n = 20;
+    auto ksk = std::make_shared<LWESwitchingKeyImpl>(N, baseKS, digitCount, n, qKS);
+    uint64_t x = 12345;
+    auto next  = [&x, &qKS]() {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        return NativeInteger(x >> 16).Mod(qKS);
+    };
+    NativeVector a(n, qKS);
+    for (uint32_t i = 0; i < N; ++i) {
+        for (uint32_t j = 0; j < digitCount; ++j) {
+            for (uint32_t d = 0; d < baseKS; ++d) {
+                for (uint32_t k = 0; k < n; ++k)
+                    a[k] = next();
+                ksk->SetElementA(i, j, d, a);
+                ksk->SetElementB(i, j, d, next());
+            }
+        }
+    }
+    return ksk;
+}
+
+template <typename ST>
+static void SwitchingKeyRoundTrip(const ST& sertype, const NativeInteger& qKS, bool compact) {
+    auto ksk1 = MakeSwitchingKey(qKS);
+    EXPECT_EQ(ksk1->IsCompact(), compact);
+
+    LWESwitchingKey ksk2;
+    std::stringstream s;
+    Serial::Serialize(ksk1, s, sertype);
+    Serial::Deserialize(ksk2, s, sertype);
+
+    EXPECT_EQ(*ksk1, *ksk2) << "switching key mismatch, qKS = " << qKS;
+    EXPECT_EQ(ksk2->IsCompact(), compact);
+    EXPECT_EQ(ksk2->GetStride(), ksk1->GetStride());
+    EXPECT_EQ(ksk2->GetElementA(7, 2, 3), ksk1->GetElementA(7, 2, 3));
+}
+
+TEST(UnitTestFHEWSwitchingKeySerial, Compact) {
+    SwitchingKeyRoundTrip(SerType::BINARY, NativeInteger(1 << 14), true);
+    SwitchingKeyRoundTrip(SerType::JSON, NativeInteger(1 << 16), true);
+}
+
+TEST(UnitTestFHEWSwitchingKeySerial, Wide) {
+    SwitchingKeyRoundTrip(SerType::BINARY, NativeInteger(uint64_t(1) << 35), false);
+    SwitchingKeyRoundTrip(SerType::JSON, NativeInteger((1 << 16) + 1), false);
+}
+
+// keys written before the tensor layout (version 1) cannot be loaded
+TEST(UnitTestFHEWSwitchingKeySerial, RejectsVersion1) {
+    std::stringstream s;
+    Serial::Serialize(MakeSwitchingKey(NativeInteger(1 << 14)), s, SerType::JSON);
+    std::string json        = s.str();
+    const std::string field = "\"cereal_class_version\": 2";
+    size_t pos              = json.find(field);
+    ASSERT_NE(pos, std::string::npos) << "the switching key version is not serialized";
+    json.replace(pos, field.size(), "\"cereal_class_version\": 1");
+
+    std::stringstream old(json);
+    LWESwitchingKey ksk;
+    EXPECT_THROW(Serial::Deserialize(ksk, old, SerType::JSON), OpenFHEException);
+}
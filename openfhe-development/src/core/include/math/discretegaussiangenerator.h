@@ -61,7 +61,14 @@
  * kept, which are precalculated in constructor. The method is not prone to
  * timing attacks but it is usable for single center, single deviation only.
  * It should be also noted that the memory requirement grows with the standard
- * deviation, therefore it is advised to use it with smaller deviations.   */
+ * deviation, therefore it is advised to use it with smaller deviations.
+ *
+ * For small standard deviations the inversion method can be replaced by a
+ * cumulative distribution table (CDT) sampler: the CDF of |x| is stored as
+ * 63-bit integers and every sample compares one uniform word against the whole
+ * table, so the running time does not depend on the value drawn. The table is
+ * read-only after construction, hence one generator can be shared by all threads,
+ * and the comparisons for a block of samples are independent and vectorize.   */
 
 #ifndef LBCRYPTO_INC_MATH_DISCRETEGAUSSIANGENERATOR_H_
 #define LBCRYPTO_INC_MATH_DISCRETEGAUSSIANGENERATOR_H_
@@ -78,6 +85,14 @@ namespace lbcrypto {
 
 constexpr double KARNEY_THRESHOLD = 300.0;
 
+/**
+ * @brief Sampling method used for standard deviations below KARNEY_THRESHOLD
+ */
+enum GaussianSamplingMethod {
+    PEIKERT_INVERSION = 0,  // floating-point CDF, binary search per sample
+    CDT_CONSTANT_TIME = 1,  // integer CDF, full table scan per sample
+};
+
 /**
  * @brief The class for Discrete Gaussion Distribution generator.
  */
@@ -89,8 +104,9 @@ public:
    * modulus.
    * @param modulus The modulus to use to generate discrete values.
    * @param std     The standard deviation for this Gaussian Distribution.
+   * @param method  The sampling method used when std < KARNEY_THRESHOLD.
    */
-    explicit DiscreteGaussianGeneratorImpl(double std = 1.0);
+    explicit DiscreteGaussianGeneratorImpl(double std = 1.0, GaussianSamplingMethod method = PEIKERT_INVERSION);
 
     /**
    * @brief Destructor
@@ -119,6 +135,19 @@ public:
    */
     void SetStd(double std);
 
+    /**
+   * @brief  Returns the sampling method used for small standard deviations.
+   */
+    GaussianSamplingMethod GetSamplingMethod() const;
+
+    /**
+   * @brief        Selects the sampling method used for small standard deviations
+   * and builds its tables.
+   * @param method PEIKERT_INVERSION or CDT_CONSTANT_TIME; the latter requires
+   * std < KARNEY_THRESHOLD.
+   */
+    void SetSamplingMethod(GaussianSamplingMethod method);
+
     /**
    * @brief      Returns a generated signed integer. Uses Peikert's Inversion
    * Method
@@ -135,6 +164,24 @@ public:
    */
     std::shared_ptr<int64_t> GenerateIntVector(uint32_t size) const;
 
+    /**
+   * @brief      Fills a caller-provided buffer with generated signed integers,
+   * using the selected sampling method.
+   * @param out  The output buffer.
+   * @param size The number of values to generate.
+   */
+    void GenerateIntVector(int32_t* out, size_t size) const;
+
+    /**
+   * @brief      Same as GenerateIntVector(out, size), but draws the randomness
+   * from the given engine instead of the thread's PRNG. With a deterministically
+   * seeded engine the samples are reproducible.
+   * @param prng The random engine.
+   * @param out  The output buffer.
+   * @param size The number of values to generate.
+   */
+    void GenerateIntVector(PRNG& prng, int32_t* out, size_t size) const;
+
     /**
    * @brief  Returns a generated integer. Uses Peikert's inversion method.
    * @return A random value within this Discrete Gaussian Distribution.
@@ -190,6 +237,11 @@ public:
    */
     static int64_t GenerateIntegerKarney(double mean, double stddev);
 
+    /**
+   * @brief Same as GenerateIntegerKarney(mean, stddev) with the given engine.
+   */
+    static int64_t GenerateIntegerKarney(PRNG& g, double mean, double stddev);
+
 private:
     // Gyana to add precomputation methods and data members
     // all parameters are set as int because it is assumed that they are used for
@@ -198,9 +250,20 @@ private:
     double m_a{0.0};
     std::vector<double> m_vals;
     bool peikert{false};
+    GaussianSamplingMethod m_method{PEIKERT_INVERSION};
+    // m_cdt[k] = floor(2^63 * Pr[|x| <= k]); entries equal to 2^63 are dropped
+    std::vector<uint64_t> m_cdt;
 
     uint32_t FindInVector(const std::vector<double>& S, double search) const;
 
+    void InitializeCDT();
+
+    /**
+   * @brief Maps uniform 64-bit words to samples: the low 63 bits are compared
+   * with every table entry, the top bit gives the sign.
+   */
+    void SampleCDT(const uint64_t* words, int32_t* out, size_t size) const;
+
     static double UnnormalizedGaussianPDF(const double& mean, const double& sigma, int32_t x) {
         return pow(M_E, -pow(x - mean, 2) / (2. * sigma * sigma));
     }
@@ -77,6 +77,14 @@ public:
     VecType GenerateVector(const uint32_t size, const typename VecType::Integer& modulus);
 
 private:
+    /**
+     * @brief Fills v with mask-and-reject samples for moduli of at most 64 bits: Word-sized
+     * values are read in bulk from the PRNG and masked to the bit length of m_modulus - 1,
+     * so every value is accepted with probability above 1/2.
+     */
+    template <typename Word>
+    void GenerateVectorMaskAndReject(VecType& v, uint32_t size) const;
+
     typename VecType::Integer m_modulus{};
     uint32_t m_chunksPerValue{};
     uint32_t m_shiftChunk{};
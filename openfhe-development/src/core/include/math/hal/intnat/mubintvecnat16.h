@@ -0,0 +1,197 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ * This file contains a compact vector of residues modulo a 12-bit prime, stored as int16_t
+ */
+
+#ifndef LBCRYPTO_INC_MATH_HAL_INTNAT_MUBINTVECNAT16_H
+#define LBCRYPTO_INC_MATH_HAL_INTNAT_MUBINTVECNAT16_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <vector>
+
+namespace intnat {
+
+/**
+ * @brief Constants and scalar reductions for a modulus 2^11 < q < 2^12 with int16_t residues: signed Montgomery
+ * reduction with R = 2^16 and Barrett reduction with a 26-bit shift (as in the Kyber reference).
+ */
+struct Modulus16 {
+    Modulus16() = default;
+
+    /**
+     * @param modulus an odd 12-bit modulus; throws otherwise
+     */
+    explicit Modulus16(uint16_t modulus);
+
+    /**
+     * @return a * 2^{-16} mod q in (-q, q) for |a| < q * 2^15
+     */
+    int16_t MontgomeryReduce(int32_t a) const {
+        int16_t t = static_cast<int16_t>(static_cast<int16_t>(a) * qinv);
+        return static_cast<int16_t>((a - static_cast<int32_t>(t) * q) >> 16);
+    }
+
+    /**
+     * @return a * b * 2^{-16} mod q in (-q, q)
+     */
+    int16_t MontgomeryMultiply(int16_t a, int16_t b) const {
+        return MontgomeryReduce(static_cast<int32_t>(a) * b);
+    }
+
+    /**
+     * @return a representative of a mod q in [0, q]
+     */
+    int16_t BarrettReduce(int16_t a) const {
+        int16_t t = static_cast<int16_t>((static_cast<int32_t>(a) * barrett) >> 26);
+        return static_cast<int16_t>(a - t * q);
+    }
+
+    /**
+     * @return the canonical representative of a mod q in [0, q)
+     */
+    int16_t Freeze(int16_t a) const {
+        int16_t x = BarrettReduce(a);
+        return static_cast<int16_t>(x - q * (x >= q));
+    }
+
+    /**
+     * @return a * b mod q in [0, q) for |a|, |b| < q
+     */
+    int16_t ModMul(int16_t a, int16_t b) const {
+        return Freeze(MontgomeryMultiply(MontgomeryMultiply(a, b), montR2));
+    }
+
+    int16_t q{0};
+    // q^{-1} mod 2^16
+    int16_t qinv{0};
+    // round(2^26 / q)
+    int16_t barrett{0};
+    // 2^32 mod q, centered
+    int16_t montR2{0};
+};
+
+/**
+ * @brief Vector of residues modulo a 12-bit prime stored as int16_t in [0, q): a quarter of the memory of
+ * NativeVector and 16 values per AVX2 register. Used with IncompleteNTT16 and Poly16 for KEM-sized arithmetic.
+ */
+class NativeVector16 {
+public:
+    NativeVector16() = default;
+
+    /**
+     * Creates a zero vector.
+     */
+    NativeVector16(uint32_t length, uint16_t modulus);
+
+    /**
+     * Creates a vector from signed values, reduced to [0, q); missing entries are zero.
+     */
+    NativeVector16(uint32_t length, uint16_t modulus, std::initializer_list<int64_t> values);
+
+    uint32_t GetLength() const {
+        return static_cast<uint32_t>(m_data.size());
+    }
+
+    uint16_t GetModulus() const {
+        return static_cast<uint16_t>(m_modulus.q);
+    }
+
+    const Modulus16& GetModulus16() const {
+        return m_modulus;
+    }
+
+    int16_t& operator[](size_t i) {
+        return m_data[i];
+    }
+
+    const int16_t& operator[](size_t i) const {
+        return m_data[i];
+    }
+
+    int16_t* data() {
+        return m_data.data();
+    }
+
+    const int16_t* data() const {
+        return m_data.data();
+    }
+
+    /**
+     * Maps every entry, any int16_t value, to its representative in [0, q).
+     */
+    void Reduce();
+
+    // element-wise arithmetic mod q; operands must have the same length and modulus, entries in [0, q)
+    NativeVector16& ModAddEq(const NativeVector16& b);
+    NativeVector16& ModSubEq(const NativeVector16& b);
+    NativeVector16& ModMulEq(const NativeVector16& b);
+
+    /**
+     * Adds b mod q to the entry at index i, keeping it in [0, q).
+     */
+    NativeVector16& ModAddAtIndex(uint32_t i, int64_t b);
+
+    NativeVector16 ModAdd(const NativeVector16& b) const {
+        return NativeVector16(*this).ModAddEq(b);
+    }
+
+    NativeVector16 ModSub(const NativeVector16& b) const {
+        return NativeVector16(*this).ModSubEq(b);
+    }
+
+    NativeVector16 ModMul(const NativeVector16& b) const {
+        return NativeVector16(*this).ModMulEq(b);
+    }
+
+    bool operator==(const NativeVector16& b) const {
+        return m_modulus.q == b.m_modulus.q && m_data == b.m_data;
+    }
+
+    bool operator!=(const NativeVector16& b) const {
+        return !(*this == b);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const NativeVector16& v);
+
+private:
+    void CheckCompatible(const NativeVector16& b) const;
+
+    Modulus16 m_modulus;
+    std::vector<int16_t> m_data;
+};
+
+}  // namespace intnat
+
+#endif
@@ -82,7 +82,11 @@ public:
     std::shared_ptr<int32_t> GenerateIntVector(usint size, usint h = 0) const;
 
 private:
-    static std::uniform_int_distribution<int> m_distribution;
+    /**
+     * @brief Fills out with uniform values in {-1, 0, 1}: the PRNG bytes are split into
+     * four 2-bit candidates and the candidate 3 is rejected.
+     */
+    static void FillTernary(int32_t* out, usint size);
 };
 
 }  // namespace lbcrypto
@@ -38,6 +38,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <new>
 #include <utility>
 #include <vector>
 
@@ -55,6 +56,43 @@ void MoveAppend(std::vector<X>& dst, std::vector<X>& src) {
     }
 }
 
+/**
+ * @brief Allocator for containers whose storage must start on an Alignment-byte boundary
+ *        (a cache line by default), e.g. buffers processed by SIMD kernels.
+ */
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}  // NOLINT
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept {
+        return false;
+    }
+};
+
 /**
  * @brief secure_memset() is a function with the same functionality which is provided by std::memset.
  *        Usually, the compiler optimizes a call to std::memset out if it is called for a memory which goes out of scope.
@@ -186,6 +186,10 @@ int blake2xs(void *out, size_t outlen, const void *in, size_t inlen,
              const void *key, size_t keylen);
 int blake2xb(void *out, size_t outlen, const void *in, size_t inlen,
              const void *key, size_t keylen);
+/* Same output as blake2xb; the 64-byte output blocks are hashed four at a
+   time with AVX2 when the CPU supports it */
+int blake2xb_x4(void *out, size_t outlen, const void *in, size_t inlen,
+                const void *key, size_t keylen);
 
 /* This is simply an alias for blake2b */
 int blake2(void *out, size_t outlen, const void *in, size_t inlen,
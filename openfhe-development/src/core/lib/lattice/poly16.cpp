@@ -0,0 +1,110 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2023, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Represents ring elements modulo a 12-bit prime with int16_t coefficients
+ */
+
+#include "lattice/hal/default/poly16.h"
+#include "utils/exception.h"
+
+#include <utility>
+
+namespace lbcrypto {
+
+Poly16::Poly16(const std::shared_ptr<const Params>& params, Format format)
+    : m_params(params), m_format(format), m_values(params->GetRingDimension(), params->GetModulus()) {}
+
+void Poly16::SetValues(Vector values, Format format) {
+    if (values.GetLength() != m_params->GetRingDimension() || values.GetModulus() != m_params->GetModulus())
+        OPENFHE_THROW("Poly16::SetValues: the values do not match the ring parameters");
+    m_values = std::move(values);
+    m_values.Reduce();
+    m_format = format;
+}
+
+void Poly16::SwitchFormat() {
+    if (m_format == Format::COEFFICIENT) {
+        m_params->ForwardTransform(m_values.data());
+        m_format = Format::EVALUATION;
+    }
+    else {
+        m_params->InverseTransform(m_values.data());
+        m_format = Format::COEFFICIENT;
+    }
+    m_params->Reduce(m_values.data());
+}
+
+void Poly16::CheckCompatible(const Poly16& b) const {
+    if (m_format != b.m_format)
+        OPENFHE_THROW("Poly16: operands in different formats");
+    if (m_params != b.m_params && (m_params->GetRingDimension() != b.m_params->GetRingDimension() ||
+                                   m_params->GetModulus() != b.m_params->GetModulus()))
+        OPENFHE_THROW("Poly16: operands in different rings");
+}
+
+Poly16& Poly16::operator+=(const Poly16& b) {
+    CheckCompatible(b);
+    m_values.ModAddEq(b.m_values);
+    return *this;
+}
+
+Poly16& Poly16::operator-=(const Poly16& b) {
+    CheckCompatible(b);
+    m_values.ModSubEq(b.m_values);
+    return *this;
+}
+
+Poly16& Poly16::operator*=(const Poly16& b) {
+    CheckCompatible(b);
+    if (m_format != Format::EVALUATION)
+        OPENFHE_THROW("Poly16: multiplication requires EVALUATION format");
+    int16_t* r = m_values.data();
+    m_params->BaseCaseMultiply(r, b.m_values.data(), r);
+    m_params->ToMontgomery(r);
+    m_params->Reduce(r);
+    return *this;
+}
+
+Poly16& Poly16::AddProductEq(const Poly16& a, const Poly16& b) {
+    CheckCompatible(a);
+    a.CheckCompatible(b);
+    if (m_format != Format::EVALUATION)
+        OPENFHE_THROW("Poly16: multiplication requires EVALUATION format");
+    m_params->BaseCaseMultiplyAdd(a.m_values.data(), b.m_values.data(), m_values.data());
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream& os, const Poly16& p) {
+    return os << p.GetValues() << " format: " << (p.GetFormat() == Format::EVALUATION ? "EVALUATION" : "COEFFICIENT");
+}
+
+}  // namespace lbcrypto
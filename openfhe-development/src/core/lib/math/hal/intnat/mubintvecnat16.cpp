@@ -0,0 +1,124 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ * This file contains the compact vector of residues modulo a 12-bit prime
+ */
+
+#include "math/hal/intnat/mubintvecnat16.h"
+#include "utils/exception.h"
+
+#include <string>
+
+namespace intnat {
+
+Modulus16::Modulus16(uint16_t modulus) {
+    if (modulus <= (1u << 11) || modulus >= (1u << 12) || modulus % 2 == 0)
+        OPENFHE_THROW("Modulus16: the modulus must be an odd 12-bit number, got " + std::to_string(modulus));
+    const uint32_t m = modulus;
+    q                = static_cast<int16_t>(modulus);
+    // q^{-1} mod 2^16 by Newton iteration
+    uint32_t inv = m;
+    for (int i = 0; i < 4; ++i)
+        inv *= 2 - m * inv;
+    qinv            = static_cast<int16_t>(inv & 0xFFFF);
+    barrett         = static_cast<int16_t>(((1u << 26) + m / 2) / m);
+    const uint32_t r2 = (1u << 16) % m * ((1u << 16) % m) % m;
+    montR2          = static_cast<int16_t>(r2 > m / 2 ? static_cast<int32_t>(r2) - q : r2);
+}
+
+NativeVector16::NativeVector16(uint32_t length, uint16_t modulus) : m_modulus(modulus), m_data(length, 0) {}
+
+NativeVector16::NativeVector16(uint32_t length, uint16_t modulus, std::initializer_list<int64_t> values)
+    : NativeVector16(length, modulus) {
+    if (values.size() > length)
+        OPENFHE_THROW("NativeVector16: more values than the vector length");
+    size_t i = 0;
+    for (int64_t x : values) {
+        int64_t r     = x % modulus;
+        m_data[i++]   = static_cast<int16_t>(r < 0 ? r + modulus : r);
+    }
+}
+
+void NativeVector16::CheckCompatible(const NativeVector16& b) const {
+    if (m_data.size() != b.m_data.size() || m_modulus.q != b.m_modulus.q)
+        OPENFHE_THROW("NativeVector16: vectors of different lengths or moduli");
+}
+
+void NativeVector16::Reduce() {
+    for (auto& x : m_data)
+        x = m_modulus.Freeze(x);
+}
+
+NativeVector16& NativeVector16::ModAddEq(const NativeVector16& b) {
+    CheckCompatible(b);
+    const int16_t q = m_modulus.q;
+    for (size_t i = 0; i < m_data.size(); ++i) {
+        int16_t x  = static_cast<int16_t>(m_data[i] + b.m_data[i]);
+        m_data[i]  = static_cast<int16_t>(x - q * (x >= q));
+    }
+    return *this;
+}
+
+NativeVector16& NativeVector16::ModSubEq(const NativeVector16& b) {
+    CheckCompatible(b);
+    const int16_t q = m_modulus.q;
+    for (size_t i = 0; i < m_data.size(); ++i) {
+        int16_t x  = static_cast<int16_t>(m_data[i] - b.m_data[i]);
+        m_data[i]  = static_cast<int16_t>(x + q * (x < 0));
+    }
+    return *this;
+}
+
+NativeVector16& NativeVector16::ModMulEq(const NativeVector16& b) {
+    CheckCompatible(b);
+    for (size_t i = 0; i < m_data.size(); ++i)
+        m_data[i] = m_modulus.ModMul(m_data[i], b.m_data[i]);
+    return *this;
+}
+
+NativeVector16& NativeVector16::ModAddAtIndex(uint32_t i, int64_t b) {
+    if (i >= m_data.size())
+        OPENFHE_THROW("NativeVector16::ModAddAtIndex: index out of range");
+    const int64_t q = m_modulus.q;
+    int64_t r       = (m_data[i] + b % q) % q;
+    m_data[i]       = static_cast<int16_t>(r < 0 ? r + q : r);
+    return *this;
+}
+
+std::ostream& operator<<(std::ostream& os, const NativeVector16& v) {
+    os << "[";
+    for (uint32_t i = 0; i < v.GetLength(); ++i)
+        os << (i ? " " : "") << v[i];
+    return os << "] modulus: " << v.GetModulus();
+}
+
+}  // namespace intnat
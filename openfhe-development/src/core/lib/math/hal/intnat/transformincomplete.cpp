@@ -0,0 +1,500 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Incomplete negacyclic NTT with 16-bit Montgomery arithmetic for small moduli: scalar and AVX2 kernels
+ */
+
+#include "math/hal/intnat/transformincomplete.h"
+#include "utils/exception.h"
+
+#include <string>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define INCOMPLETE_NTT_X86_DISPATCH
+#endif
+
+namespace intnat {
+
+namespace {
+
+uint32_t ModExp16(uint32_t base, uint32_t exp, uint32_t q) {
+    uint32_t result = 1;
+    base %= q;
+    for (; exp > 0; exp >>= 1) {
+        if (exp & 1)
+            result = result * base % q;
+        base = base * base % q;
+    }
+    return result;
+}
+
+uint32_t BitReverse(uint32_t x, uint32_t bits) {
+    uint32_t r = 0;
+    for (uint32_t i = 0; i < bits; ++i)
+        r |= ((x >> i) & 1) << (bits - 1 - i);
+    return r;
+}
+
+int16_t Centered(uint32_t x, uint32_t q) {
+    return static_cast<int16_t>(x > q / 2 ? static_cast<int32_t>(x) - static_cast<int32_t>(q) : x);
+}
+
+// group of 2*len coefficients, within a 32-coefficient block, that owns lane l of the second butterfly input in
+// the AVX2 kernels for len = 8, 4, 2 (see the lane permutations in IncompleteNTT16AVX2)
+uint32_t LaneGroup(uint32_t len, uint32_t l) {
+    static const uint32_t group4[4] = {0, 2, 1, 3};
+    static const uint32_t group2[8] = {0, 4, 1, 5, 2, 6, 3, 7};
+    if (len == 8)
+        return l / 8;
+    if (len == 4)
+        return group4[l / 4];
+    return group2[l / 2];
+}
+
+}  // namespace
+
+IncompleteNTT16::IncompleteNTT16(uint32_t n, uint16_t modulus, bool allowAVX2) : m_n(n) {
+    const uint32_t q = modulus;
+    if (n < 4 || (n & (n - 1)) != 0)
+        OPENFHE_THROW("IncompleteNTT16: the ring dimension must be a power of two >= 4");
+    if (q <= (1u << 11) || q >= (1u << 12) || (q - 1) % n != 0)
+        OPENFHE_THROW("IncompleteNTT16: the modulus must be a 12-bit prime with n | q - 1, got q = " +
+                      std::to_string(q) + ", n = " + std::to_string(n));
+    for (uint32_t d = 2; d * d <= q; ++d) {
+        if (q % d == 0)
+            OPENFHE_THROW("IncompleteNTT16: the modulus " + std::to_string(q) + " is not prime");
+    }
+
+    m_modulus = Modulus16(modulus);
+
+    // smallest zeta with zeta^{n/2} = -1, i.e. of order exactly n
+    m_root = 0;
+    for (uint32_t z = 2; z < q && m_root == 0; ++z) {
+        if (ModExp16(z, n / 2, q) == q - 1)
+            m_root = static_cast<uint16_t>(z);
+    }
+
+    const uint32_t mont = (1u << 16) % q;
+    m_inverseScale      = Centered(mont * ModExp16(n / 2, q - 2, q) % q, q);
+
+    uint32_t bits = 0;
+    while ((1u << bits) < n / 2)
+        ++bits;
+    const uint32_t rootInverse = ModExp16(m_root, q - 2, q);
+    m_zetas.resize(n / 2);
+    m_zetasInverse.resize(n / 2);
+    for (uint32_t k = 0; k < n / 2; ++k) {
+        uint32_t e         = BitReverse(k, bits);
+        m_zetas[k]         = Centered(mont * ModExp16(m_root, e, q) % q, q);
+        m_zetasInverse[k]  = Centered(mont * (q - ModExp16(rootInverse, e, q)) % q, q);
+    }
+
+    m_avx2 = false;
+#if defined(INCOMPLETE_NTT_X86_DISPATCH)
+    m_avx2 = allowAVX2 && n >= 32 && __builtin_cpu_supports("avx2");
+#endif
+    if (!m_avx2)
+        return;
+
+    auto withQinv = [this](std::vector<int16_t>& table, size_t offset) {
+        for (size_t l = 0; l < 16; ++l)
+            table[offset + 16 + l] = static_cast<int16_t>(table[offset + l] * m_modulus.qinv);
+    };
+
+    const uint32_t blocks = n / 32;
+    m_laneZetas.resize(3 * blocks * 32);
+    m_laneZetasInverse.resize(3 * blocks * 32);
+    uint32_t layer = 0;
+    for (uint32_t len = 8; len >= 2; len >>= 1, ++layer) {
+        for (uint32_t i = 0; i < blocks; ++i) {
+            const size_t offset = (layer * blocks + i) * 32;
+            for (uint32_t l = 0; l < 16; ++l) {
+                uint32_t k                     = n / (2 * len) + i * (16 / len) + LaneGroup(len, l);
+                m_laneZetas[offset + l]        = m_zetas[k];
+                m_laneZetasInverse[offset + l] = m_zetasInverse[k];
+            }
+            withQinv(m_laneZetas, offset);
+            withQinv(m_laneZetasInverse, offset);
+        }
+    }
+
+    // lane 2d holds pair 16i + d and lane 2d + 1 holds pair 16i + 8 + d; pair p is reduced modulo
+    // X^2 - zeta_p with zeta_p = +-zetas[n/4 + p/2]
+    m_laneZetasBaseCase.resize(blocks * 32);
+    for (uint32_t i = 0; i < blocks; ++i) {
+        for (uint32_t l = 0; l < 16; ++l) {
+            uint32_t p                          = 16 * i + (l % 2) * 8 + l / 2;
+            int16_t zeta                        = m_zetas[n / 4 + p / 2];
+            m_laneZetasBaseCase[i * 32 + l]     = (p % 2 == 0) ? zeta : static_cast<int16_t>(-zeta);
+        }
+        withQinv(m_laneZetasBaseCase, i * 32);
+    }
+}
+
+void IncompleteNTT16::ForwardTransformScalar(int16_t* r) const {
+    uint32_t k = 1;
+    for (uint32_t len = m_n / 2; len >= 2; len >>= 1) {
+        for (uint32_t start = 0; start < m_n; start += 2 * len) {
+            const int16_t zeta = m_zetas[k++];
+            for (uint32_t j = start; j < start + len; ++j) {
+                int16_t t  = MontgomeryMultiply(zeta, r[j + len]);
+                r[j + len] = static_cast<int16_t>(r[j] - t);
+                r[j]       = static_cast<int16_t>(r[j] + t);
+            }
+        }
+    }
+    for (uint32_t i = 0; i < m_n; ++i)
+        r[i] = BarrettReduce(r[i]);
+}
+
+void IncompleteNTT16::InverseTransformScalar(int16_t* r) const {
+    for (uint32_t len = 2; len <= m_n / 2; len <<= 1) {
+        uint32_t k = m_n / (2 * len);
+        for (uint32_t start = 0; start < m_n; start += 2 * len) {
+            const int16_t zeta = m_zetasInverse[k++];
+            for (uint32_t j = start; j < start + len; ++j) {
+                int16_t t  = r[j];
+                r[j]       = BarrettReduce(static_cast<int16_t>(t + r[j + len]));
+                r[j + len] = MontgomeryMultiply(zeta, static_cast<int16_t>(r[j + len] - t));
+            }
+        }
+    }
+    for (uint32_t i = 0; i < m_n; ++i)
+        r[i] = MontgomeryMultiply(r[i], m_inverseScale);
+}
+
+void IncompleteNTT16::BaseCaseMultiplyScalar(const int16_t* a, const int16_t* b, int16_t* r) const {
+    for (uint32_t p = 0; p < m_n / 2; ++p) {
+        int16_t zeta = m_zetas[m_n / 4 + p / 2];
+        if (p % 2 == 1)
+            zeta = static_cast<int16_t>(-zeta);
+        const int16_t a0 = a[2 * p], a1 = a[2 * p + 1];
+        const int16_t b0 = b[2 * p], b1 = b[2 * p + 1];
+        r[2 * p] = static_cast<int16_t>(MontgomeryMultiply(MontgomeryMultiply(a1, b1), zeta) +
+                                        MontgomeryMultiply(a0, b0));
+        r[2 * p + 1] = static_cast<int16_t>(MontgomeryMultiply(a0, b1) + MontgomeryMultiply(a1, b0));
+    }
+}
+
+void IncompleteNTT16::BaseCaseMultiplyAddScalar(const int16_t* a, const int16_t* b, int16_t* acc) const {
+    for (uint32_t p = 0; p < m_n / 2; ++p) {
+        int16_t zeta = m_zetas[m_n / 4 + p / 2];
+        if (p % 2 == 1)
+            zeta = static_cast<int16_t>(-zeta);
+        const int16_t a0 = a[2 * p], a1 = a[2 * p + 1];
+        const int16_t b0 = b[2 * p], b1 = b[2 * p + 1];
+        const int16_t r0 = static_cast<int16_t>(MontgomeryMultiply(MontgomeryMultiply(a1, b1), zeta) +
+                                                MontgomeryMultiply(a0, b0));
+        const int16_t r1 = static_cast<int16_t>(MontgomeryMultiply(a0, b1) + MontgomeryMultiply(a1, b0));
+        // times 2^16 the products are in (-q, q), so the sums with acc stay within int16_t
+        acc[2 * p] =
+            m_modulus.Freeze(static_cast<int16_t>(acc[2 * p] + MontgomeryMultiply(r0, m_modulus.montR2)));
+        acc[2 * p + 1] =
+            m_modulus.Freeze(static_cast<int16_t>(acc[2 * p + 1] + MontgomeryMultiply(r1, m_modulus.montR2)));
+    }
+}
+
+#if defined(INCOMPLETE_NTT_X86_DISPATCH)
+
+__attribute__((target("avx2"))) static inline __m256i MontgomeryMultiplyAVX2(__m256i a, __m256i b, __m256i bqinv,
+                                                                             __m256i q) {
+    // the low halves of a * b and t * q cancel, so the high halves give (a * b - t * q) / 2^16
+    __m256i t = _mm256_mullo_epi16(a, bqinv);
+    return _mm256_sub_epi16(_mm256_mulhi_epi16(a, b), _mm256_mulhi_epi16(t, q));
+}
+
+__attribute__((target("avx2"))) static inline __m256i BarrettReduceAVX2(__m256i a, __m256i v, __m256i q) {
+    __m256i t = _mm256_srai_epi16(_mm256_mulhi_epi16(a, v), 10);
+    return _mm256_sub_epi16(a, _mm256_mullo_epi16(t, q));
+}
+
+// Splits the 32 coefficients (x0, x1) of a block into the first (a) and second (b) inputs of the butterflies of
+// distance len = 8, 4, 2, and back
+__attribute__((target("avx2"))) static inline void SplitLanes(uint32_t len, __m256i x0, __m256i x1, __m256i& a,
+                                                              __m256i& b) {
+    if (len == 8) {
+        a = _mm256_permute2x128_si256(x0, x1, 0x20);
+        b = _mm256_permute2x128_si256(x0, x1, 0x31);
+    }
+    else if (len == 4) {
+        a = _mm256_unpacklo_epi64(x0, x1);
+        b = _mm256_unpackhi_epi64(x0, x1);
+    }
+    else {
+        a = _mm256_blend_epi32(x0, _mm256_slli_epi64(x1, 32), 0xAA);
+        b = _mm256_blend_epi32(_mm256_srli_epi64(x0, 32), x1, 0xAA);
+    }
+}
+
+__attribute__((target("avx2"))) static inline void MergeLanes(uint32_t len, __m256i a, __m256i b, __m256i& x0,
+                                                              __m256i& x1) {
+    if (len == 8) {
+        x0 = _mm256_permute2x128_si256(a, b, 0x20);
+        x1 = _mm256_permute2x128_si256(a, b, 0x31);
+    }
+    else if (len == 4) {
+        x0 = _mm256_unpacklo_epi64(a, b);
+        x1 = _mm256_unpackhi_epi64(a, b);
+    }
+    else {
+        x0 = _mm256_blend_epi32(a, _mm256_slli_epi64(b, 32), 0xAA);
+        x1 = _mm256_blend_epi32(_mm256_srli_epi64(a, 32), b, 0xAA);
+    }
+}
+
+// Loads 16 pairs: the even lanes of the result hold the first coefficients of the pairs and the odd lanes the
+// second ones; lane 2d is pair d and lane 2d + 1 is pair 8 + d
+__attribute__((target("avx2"))) static inline void SplitPairs(const int16_t* p, __m256i& c0, __m256i& c1) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 16));
+    c0        = _mm256_blend_epi16(x, _mm256_slli_epi32(y, 16), 0xAA);
+    c1        = _mm256_blend_epi16(_mm256_srli_epi32(x, 16), y, 0xAA);
+}
+
+struct IncompleteNTT16AVX2 {
+    static void Forward(const IncompleteNTT16& ntt, int16_t* r);
+    static void Inverse(const IncompleteNTT16& ntt, int16_t* r);
+    static void BaseCaseMultiply(const IncompleteNTT16& ntt, const int16_t* a, const int16_t* b, int16_t* r);
+    static void BaseCaseMultiplyAdd(const IncompleteNTT16& ntt, const int16_t* a, const int16_t* b, int16_t* acc);
+};
+
+__attribute__((target("avx2"))) void IncompleteNTT16AVX2::Forward(const IncompleteNTT16& ntt, int16_t* r) {
+    const uint32_t n      = ntt.m_n;
+    const uint32_t blocks = n / 32;
+    const __m256i q       = _mm256_set1_epi16(ntt.m_modulus.q);
+
+    // distances >= 16: the same zeta for whole registers
+    for (uint32_t len = n / 2; len >= 16; len >>= 1) {
+        uint32_t k = n / (2 * len);
+        for (uint32_t start = 0; start < n; start += 2 * len, ++k) {
+            const __m256i z  = _mm256_set1_epi16(ntt.m_zetas[k]);
+            const __m256i zq = _mm256_set1_epi16(static_cast<int16_t>(ntt.m_zetas[k] * ntt.m_modulus.qinv));
+            for (uint32_t j = start; j < start + len; j += 16) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + j));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + j + len));
+                __m256i t = MontgomeryMultiplyAVX2(b, z, zq, q);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + j + len), _mm256_sub_epi16(a, t));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + j), _mm256_add_epi16(a, t));
+            }
+        }
+    }
+
+    // distances 8, 4, 2 inside 32-coefficient blocks
+    uint32_t layer = 0;
+    for (uint32_t len = 8; len >= 2; len >>= 1, ++layer) {
+        const int16_t* zetas = ntt.m_laneZetas.data() + layer * blocks * 32;
+        for (uint32_t i = 0; i < blocks; ++i) {
+            __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + 32 * i));
+            __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + 32 * i + 16));
+            __m256i a, b;
+            SplitLanes(len, x0, x1, a, b);
+            const __m256i z  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(zetas + 32 * i));
+            const __m256i zq = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(zetas + 32 * i + 16));
+            __m256i t        = MontgomeryMultiplyAVX2(b, z, zq, q);
+            MergeLanes(len, _mm256_add_epi16(a, t), _mm256_sub_epi16(a, t), x0, x1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + 32 * i), x0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + 32 * i + 16), x1);
+        }
+    }
+
+    const __m256i v = _mm256_set1_epi16(ntt.m_modulus.barrett);
+    for (uint32_t j = 0; j < n; j += 16) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + j), BarrettReduceAVX2(x, v, q));
+    }
+}
+
+__attribute__((target("avx2"))) void IncompleteNTT16AVX2::Inverse(const IncompleteNTT16& ntt, int16_t* r) {
+    const uint32_t n      = ntt.m_n;
+    const uint32_t blocks = n / 32;
+    const __m256i q       = _mm256_set1_epi16(ntt.m_modulus.q);
+    const __m256i v       = _mm256_set1_epi16(ntt.m_modulus.barrett);
+
+    // distances 2, 4, 8 inside 32-coefficient blocks
+    for (uint32_t len = 2, layer = 2; len <= 8; len <<= 1, --layer) {
+        const int16_t* zetas = ntt.m_laneZetasInverse.data() + layer * blocks * 32;
+        for (uint32_t i = 0; i < blocks; ++i) {
+            __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + 32 * i));
+            __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + 32 * i + 16));
+            __m256i a, b;
+            SplitLanes(len, x0, x1, a, b);
+            const __m256i z  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(zetas + 32 * i));
+            const __m256i zq = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(zetas + 32 * i + 16));
+            __m256i sum      = BarrettReduceAVX2(_mm256_add_epi16(a, b), v, q);
+            __m256i diff     = MontgomeryMultiplyAVX2(_mm256_sub_epi16(b, a), z, zq, q);
+            MergeLanes(len, sum, diff, x0, x1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + 32 * i), x0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + 32 * i + 16), x1);
+        }
+    }
+
+    for (uint32_t len = 16; len <= n / 2; len <<= 1) {
+        uint32_t k = n / (2 * len);
+        for (uint32_t start = 0; start < n; start += 2 * len, ++k) {
+            const __m256i z  = _mm256_set1_epi16(ntt.m_zetasInverse[k]);
+            const __m256i zq = _mm256_set1_epi16(static_cast<int16_t>(ntt.m_zetasInverse[k] * ntt.m_modulus.qinv));
+            for (uint32_t j = start; j < start + len; j += 16) {
+                __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + j));
+                __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + j + len));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + j), BarrettReduceAVX2(_mm256_add_epi16(a, b), v, q));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + j + len),
+                                    MontgomeryMultiplyAVX2(_mm256_sub_epi16(b, a), z, zq, q));
+            }
+        }
+    }
+
+    const __m256i f  = _mm256_set1_epi16(ntt.m_inverseScale);
+    const __m256i fq = _mm256_set1_epi16(static_cast<int16_t>(ntt.m_inverseScale * ntt.m_modulus.qinv));
+    for (uint32_t j = 0; j < n; j += 16) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + j));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + j), MontgomeryMultiplyAVX2(x, f, fq, q));
+    }
+}
+
+__attribute__((target("avx2"))) void IncompleteNTT16AVX2::BaseCaseMultiply(const IncompleteNTT16& ntt,
+                                                                           const int16_t* a, const int16_t* b,
+                                                                           int16_t* r) {
+    const __m256i q    = _mm256_set1_epi16(ntt.m_modulus.q);
+    const __m256i qinv = _mm256_set1_epi16(ntt.m_modulus.qinv);
+    const int16_t* zetas = ntt.m_laneZetasBaseCase.data();
+
+    for (uint32_t i = 0; i < ntt.m_n / 32; ++i) {
+        __m256i a0, a1, b0, b1;
+        SplitPairs(a + 32 * i, a0, a1);
+        SplitPairs(b + 32 * i, b0, b1);
+        const __m256i z  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(zetas + 32 * i));
+        const __m256i zq = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(zetas + 32 * i + 16));
+        const __m256i b0q = _mm256_mullo_epi16(b0, qinv);
+        const __m256i b1q = _mm256_mullo_epi16(b1, qinv);
+
+        __m256i t  = MontgomeryMultiplyAVX2(a1, b1, b1q, q);
+        __m256i r0 = _mm256_add_epi16(MontgomeryMultiplyAVX2(t, z, zq, q), MontgomeryMultiplyAVX2(a0, b0, b0q, q));
+        __m256i r1 = _mm256_add_epi16(MontgomeryMultiplyAVX2(a0, b1, b1q, q), MontgomeryMultiplyAVX2(a1, b0, b0q, q));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + 32 * i),
+                            _mm256_blend_epi16(r0, _mm256_slli_epi32(r1, 16), 0xAA));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(r + 32 * i + 16),
+                            _mm256_blend_epi16(_mm256_srli_epi32(r0, 16), r1, 0xAA));
+    }
+}
+
+__attribute__((target("avx2"))) void IncompleteNTT16AVX2::BaseCaseMultiplyAdd(const IncompleteNTT16& ntt,
+                                                                              const int16_t* a, const int16_t* b,
+                                                                              int16_t* acc) {
+    const __m256i q       = _mm256_set1_epi16(ntt.m_modulus.q);
+    const __m256i qm1     = _mm256_set1_epi16(static_cast<int16_t>(ntt.m_modulus.q - 1));
+    const __m256i qinv    = _mm256_set1_epi16(ntt.m_modulus.qinv);
+    const __m256i barrett = _mm256_set1_epi16(ntt.m_modulus.barrett);
+    const __m256i r2      = _mm256_set1_epi16(ntt.m_modulus.montR2);
+    const __m256i r2q     = _mm256_set1_epi16(static_cast<int16_t>(ntt.m_modulus.montR2 * ntt.m_modulus.qinv));
+    const int16_t* zetas  = ntt.m_laneZetasBaseCase.data();
+
+    for (uint32_t i = 0; i < ntt.m_n / 32; ++i) {
+        __m256i a0, a1, b0, b1;
+        SplitPairs(a + 32 * i, a0, a1);
+        SplitPairs(b + 32 * i, b0, b1);
+        const __m256i z   = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(zetas + 32 * i));
+        const __m256i zq  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(zetas + 32 * i + 16));
+        const __m256i b0q = _mm256_mullo_epi16(b0, qinv);
+        const __m256i b1q = _mm256_mullo_epi16(b1, qinv);
+
+        __m256i t  = MontgomeryMultiplyAVX2(a1, b1, b1q, q);
+        __m256i r0 = _mm256_add_epi16(MontgomeryMultiplyAVX2(t, z, zq, q), MontgomeryMultiplyAVX2(a0, b0, b0q, q));
+        __m256i r1 = _mm256_add_epi16(MontgomeryMultiplyAVX2(a0, b1, b1q, q), MontgomeryMultiplyAVX2(a1, b0, b0q, q));
+
+        __m256i p[2] = {_mm256_blend_epi16(r0, _mm256_slli_epi32(r1, 16), 0xAA),
+                        _mm256_blend_epi16(_mm256_srli_epi32(r0, 16), r1, 0xAA)};
+        for (uint32_t h = 0; h < 2; ++h) {
+            __m256i* dst = reinterpret_cast<__m256i*>(acc + 32 * i + 16 * h);
+            // times 2^16 the product is in (-q, q); the sum with acc in [0, q) is then frozen to [0, q)
+            __m256i x = _mm256_add_epi16(_mm256_loadu_si256(dst), MontgomeryMultiplyAVX2(p[h], r2, r2q, q));
+            x         = BarrettReduceAVX2(x, barrett, q);
+            x         = _mm256_sub_epi16(x, _mm256_and_si256(_mm256_cmpgt_epi16(x, qm1), q));
+            _mm256_storeu_si256(dst, x);
+        }
+    }
+}
+
+#endif  // INCOMPLETE_NTT_X86_DISPATCH
+
+void IncompleteNTT16::ForwardTransform(int16_t* element) const {
+#if defined(INCOMPLETE_NTT_X86_DISPATCH)
+    if (m_avx2) {
+        IncompleteNTT16AVX2::Forward(*this, element);
+        return;
+    }
+#endif
+    ForwardTransformScalar(element);
+}
+
+void IncompleteNTT16::InverseTransform(int16_t* element) const {
+#if defined(INCOMPLETE_NTT_X86_DISPATCH)
+    if (m_avx2) {
+        IncompleteNTT16AVX2::Inverse(*this, element);
+        return;
+    }
+#endif
+    InverseTransformScalar(element);
+}
+
+void IncompleteNTT16::BaseCaseMultiply(const int16_t* a, const int16_t* b, int16_t* result) const {
+#if defined(INCOMPLETE_NTT_X86_DISPATCH)
+    if (m_avx2) {
+        IncompleteNTT16AVX2::BaseCaseMultiply(*this, a, b, result);
+        return;
+    }
+#endif
+    BaseCaseMultiplyScalar(a, b, result);
+}
+
+void IncompleteNTT16::BaseCaseMultiplyAdd(const int16_t* a, const int16_t* b, int16_t* acc) const {
+#if defined(INCOMPLETE_NTT_X86_DISPATCH)
+    if (m_avx2) {
+        IncompleteNTT16AVX2::BaseCaseMultiplyAdd(*this, a, b, acc);
+        return;
+    }
+#endif
+    BaseCaseMultiplyAddScalar(a, b, acc);
+}
+
+void IncompleteNTT16::ToMontgomery(int16_t* element) const {
+    for (uint32_t i = 0; i < m_n; ++i)
+        element[i] = MontgomeryMultiply(element[i], m_modulus.montR2);
+}
+
+void IncompleteNTT16::Reduce(int16_t* element) const {
+    for (uint32_t i = 0; i < m_n; ++i)
+        element[i] = m_modulus.Freeze(element[i]);
+}
+
+}  // namespace intnat
@@ -33,10 +33,18 @@
   hash utilities
  */
 
+#include <algorithm>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include "utils/hashutil.h"
 
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <cpuid.h>
+    #include <immintrin.h>
+    #define HASHUTIL_X86_DISPATCH
+#endif
+
 namespace lbcrypto {
 
 #define RIGHT_ROT(x, n) ((x >> (n % (sizeof(x) * 8)) | (x << ((sizeof(x) * 8) - (n % (sizeof(x) * 8))))))
@@ -69,35 +77,35 @@ const uint64_t HashUtil::k_512[80] = {
     0x113f9804bef90dae, 0x1b710b35131c471b, 0x28db77f523047d84, 0x32caab7b40c72493, 0x3c9ebe0a15c9bebc,
     0x431d67c49c100d4c, 0x4cc5d4becb3e42b6, 0x597f299cfc657e2a, 0x5fcb6fab3ad6faec, 0x6c44198c4a475817};
 
-void HashUtil::SHA256(std::string message, std::vector<int64_t>& digest) {
-    uint32_t h_256[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-                         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+void HashUtil::SHA256(const std::string& message, std::vector<int64_t>& digest) {
+    SHA256Digest bytes;
+    SHA256Bytes(message.data(), message.size(), bytes.data());
+    digest.insert(digest.end(), bytes.begin(), bytes.end());
+}
 
-    uint64_t m_len   = message.size() * 8;
-    uint16_t pad_len = 1;
-    while ((m_len + pad_len) % 512 != 448) {
-        pad_len++;
-    }
-    message.push_back(0);
-    for (int a = 0; a < (pad_len) / 8 - 1; a++) {
-        message.push_back(0);
-    }
-    message.push_back((uint8_t)((m_len & 0xff00000000000000) >> 56));
-    message.push_back((uint8_t)((m_len & 0x00ff000000000000) >> 48));
-    message.push_back((uint8_t)((m_len & 0x0000ff0000000000) >> 40));
-    message.push_back((uint8_t)((m_len & 0x000000ff00000000) >> 32));
-    message.push_back((uint8_t)((m_len & 0x00000000ff000000) >> 24));
-    message.push_back((uint8_t)((m_len & 0x0000000000ff0000) >> 16));
-    message.push_back((uint8_t)((m_len & 0x000000000000ff00) >> 8));
-    message.push_back((uint8_t)(m_len & 0x00000000000000ff));
-
-    for (size_t n = 0; n < (message.size() * 8) / 512; n++) {
+static bool CPUHasSHAExtensions() {
+#if defined(HASHUTIL_X86_DISPATCH)
+    uint32_t eax, ebx, ecx, edx;
+    // CPUID.(EAX=7,ECX=0):EBX[29] reports the SHA extensions
+    return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 29));
+#else
+    return false;
+#endif
+}
+
+void HashUtil::SHA256Compress(uint32_t* h_256, const uint8_t* blocks, size_t nblocks) {
+    using CompressFn = void (*)(uint32_t*, const uint8_t*, size_t);
+    static const CompressFn compress = CPUHasSHAExtensions() ? SHA256CompressSHANI : SHA256CompressGeneric;
+    compress(h_256, blocks, nblocks);
+}
+
+void HashUtil::SHA256CompressGeneric(uint32_t* h_256, const uint8_t* blocks, size_t nblocks) {
+    for (size_t n = 0; n < nblocks; n++) {
+        const uint8_t* block = blocks + 64 * n;
         uint32_t w[64];
-        short counter = 0;  // NOLINT
-        for (size_t m = 64 * n; m < (64 * (n + 1)); m += 4) {
-            w[counter] = ((uint32_t)message.at(m) << 24) ^ ((uint32_t)message.at(m + 1) << 16) ^
-                         ((uint32_t)message.at(m + 2) << 8) ^ ((uint32_t)message.at(m + 3));
-            counter++;
+        for (size_t i = 0; i < 16; i++) {
+            w[i] = ((uint32_t)block[4 * i] << 24) ^ ((uint32_t)block[4 * i + 1] << 16) ^
+                   ((uint32_t)block[4 * i + 2] << 8) ^ ((uint32_t)block[4 * i + 3]);
         }
         for (int i = 16; i < 64; i++) {
             uint32_t s0 = ((uint32_t)RIGHT_ROT(w[i - 15], 7)) ^ ((uint32_t)(RIGHT_ROT(w[i - 15], 18))) ^
@@ -143,162 +151,244 @@ void HashUtil::SHA256(std::string message, std::vector<int64_t>& digest) {
         h_256[6] += g;
         h_256[7] += h;
     }
+}
+
+#if defined(HASHUTIL_X86_DISPATCH)
+// Based on the Intel SHA extensions reference code: the state is kept as ABEF/CDGH and each
+// _mm_sha256rnds2_epu32 performs two rounds
+__attribute__((target("sha,sse4.1"))) void HashUtil::SHA256CompressSHANI(uint32_t* h_256, const uint8_t* blocks,
+                                                                        size_t nblocks) {
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&h_256[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&h_256[4]));
+    tmp            = _mm_shuffle_epi32(tmp, 0xB1);          // CDAB
+    state1         = _mm_shuffle_epi32(state1, 0x1B);       // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);       // ABEF
+    state1         = _mm_blend_epi16(state1, tmp, 0xF0);    // CDGH
+
+    for (size_t n = 0; n < nblocks; n++) {
+        const uint8_t* block = blocks + 64 * n;
+        __m128i abefSave     = state0;
+        __m128i cdghSave     = state1;
+        __m128i w[4];
+
+#pragma GCC unroll 16
+        for (size_t g = 0; g < 16; g++) {
+            // w[g % 4] holds message words 4g..4g+3
+            if (g < 4) {
+                w[g] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * g)), MASK);
+            }
+            else {
+                __m128i t = _mm_sha256msg1_epu32(w[g & 3], w[(g - 3) & 3]);
+                t         = _mm_add_epi32(t, _mm_alignr_epi8(w[(g - 1) & 3], w[(g - 2) & 3], 4));
+                w[g & 3]  = _mm_sha256msg2_epu32(t, w[(g - 1) & 3]);
+            }
+            __m128i msg = _mm_add_epi32(w[g & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(&k_256[4 * g])));
+            state1      = _mm_sha256rnds2_epu32(state1, state0, msg);
+            msg         = _mm_shuffle_epi32(msg, 0x0E);
+            state0      = _mm_sha256rnds2_epu32(state0, state1, msg);
+        }
 
-    for (int i = 0; i < 8; i++) {
-        digest.push_back((uint8_t)((h_256[i] & 0xff000000) >> 24));
-        digest.push_back((uint8_t)((h_256[i] & 0x00ff0000) >> 16));
-        digest.push_back((uint8_t)((h_256[i] & 0x0000ff00) >> 8));
-        digest.push_back((uint8_t)(h_256[i] & 0x000000ff));
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
     }
 
-    return;
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);       // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);       // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);    // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);       // ABEF
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&h_256[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&h_256[4]), state1);
 }
 
-std::string HashUtil::HashString(std::string message) {
-    uint32_t h_256[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-                         0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    #define ROTR_X8(x, n) _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - (n)))
+
+// loads 8 big-endian words from each of the 8 blocks and transposes them, so that lane i of
+// w[t] holds word t of block i
+__attribute__((target("avx2"))) static void LoadTransposedX8(const uint8_t* const* blocks, size_t offset,
+                                                             __m256i* w) {
+    const __m256i BSWAP = _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9,
+                                          10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    __m256i r[8];
+    for (size_t i = 0; i < 8; i++)
+        r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[i] + offset));
+
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+    w[0] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x20), BSWAP);
+    w[1] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x20), BSWAP);
+    w[2] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x20), BSWAP);
+    w[3] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x20), BSWAP);
+    w[4] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u0, u4, 0x31), BSWAP);
+    w[5] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u1, u5, 0x31), BSWAP);
+    w[6] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u2, u6, 0x31), BSWAP);
+    w[7] = _mm256_shuffle_epi8(_mm256_permute2x128_si256(u3, u7, 0x31), BSWAP);
+}
 
-    uint64_t m_len   = message.size() * 8;
-    uint16_t pad_len = 1;
-    while ((m_len + pad_len) % 512 != 448) {
-        pad_len++;
+// one compression of 8 independent states, lane i of state[j] being word j of message i
+__attribute__((target("avx2"))) static void SHA256CompressX8(__m256i* state, const uint8_t* const* blocks,
+                                                             const uint32_t* k_256) {
+    __m256i w[64];
+    LoadTransposedX8(blocks, 0, w);
+    LoadTransposedX8(blocks, 32, w + 8);
+    for (size_t i = 16; i < 64; i++) {
+        __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(ROTR_X8(w[i - 15], 7), ROTR_X8(w[i - 15], 18)),
+                                      _mm256_srli_epi32(w[i - 15], 3));
+        __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(ROTR_X8(w[i - 2], 17), ROTR_X8(w[i - 2], 19)),
+                                      _mm256_srli_epi32(w[i - 2], 10));
+        w[i] = _mm256_add_epi32(_mm256_add_epi32(w[i - 16], s0), _mm256_add_epi32(w[i - 7], s1));
     }
 
-    message += static_cast<char>(0x80);
-    for (int a = 0; a < (pad_len) / 8 - 1; a++) {
-        message += static_cast<char>(0);
+    __m256i a = state[0];
+    __m256i b = state[1];
+    __m256i c = state[2];
+    __m256i d = state[3];
+    __m256i e = state[4];
+    __m256i f = state[5];
+    __m256i g = state[6];
+    __m256i h = state[7];
+
+    for (size_t i = 0; i < 64; i++) {
+        __m256i S1 = _mm256_xor_si256(_mm256_xor_si256(ROTR_X8(e, 6), ROTR_X8(e, 11)), ROTR_X8(e, 25));
+        __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+        __m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(h, S1), _mm256_add_epi32(ch, w[i]));
+        temp1         = _mm256_add_epi32(temp1, _mm256_set1_epi32(static_cast<int32_t>(k_256[i])));
+        __m256i S0    = _mm256_xor_si256(_mm256_xor_si256(ROTR_X8(a, 2), ROTR_X8(a, 13)), ROTR_X8(a, 22));
+        __m256i maj =
+            _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(a, c)), _mm256_and_si256(b, c));
+        __m256i temp2 = _mm256_add_epi32(S0, maj);
+
+        h = g;
+        g = f;
+        f = e;
+        e = _mm256_add_epi32(d, temp1);
+        d = c;
+        c = b;
+        b = a;
+        a = _mm256_add_epi32(temp1, temp2);
     }
-    message += static_cast<char>((m_len & 0xff00000000000000) >> 56);
-    message += static_cast<char>((m_len & 0x00ff000000000000) >> 48);
-    message += static_cast<char>((m_len & 0x0000ff0000000000) >> 40);
-    message += static_cast<char>((m_len & 0x000000ff00000000) >> 32);
-    message += static_cast<char>((m_len & 0x00000000ff000000) >> 24);
-    message += static_cast<char>((m_len & 0x0000000000ff0000) >> 16);
-    message += static_cast<char>((m_len & 0x000000000000ff00) >> 8);
-    message += static_cast<char>(m_len & 0x00000000000000ff);
-
-    for (size_t n = 0; n < (message.size() * 8) / 512; n++) {
-        uint32_t w[64];
-        short counter = 0;  // NOLINT
-        for (size_t m = 64 * n; m < (64 * (n + 1)); m += 4) {
-            w[counter] = ((uint32_t)(message.at(m) & 0xff) << 24) ^ ((uint32_t)(message.at(m + 1) & 0xff) << 16) ^
-                         ((uint32_t)(message.at(m + 2) & 0xff) << 8) ^ ((uint32_t)(message.at(m + 3) & 0xff));
-            counter++;
-        }
-        for (int i = 16; i < 64; i++) {
-            uint32_t s0 = ((uint32_t)RIGHT_ROT(w[i - 15], 7)) ^ ((uint32_t)(RIGHT_ROT(w[i - 15], 18))) ^
-                          ((uint32_t)(w[i - 15] >> 3));
-            uint32_t s1 = ((uint32_t)RIGHT_ROT(w[i - 2], 17)) ^ ((uint32_t)RIGHT_ROT(w[i - 2], 19)) ^
-                          ((uint32_t)(w[i - 2] >> 10));
-            w[i] = w[i - 16] + s0 + w[i - 7] + s1;
-        }
 
-        uint32_t a = h_256[0];
-        uint32_t b = h_256[1];
-        uint32_t c = h_256[2];
-        uint32_t d = h_256[3];
-        uint32_t e = h_256[4];
-        uint32_t f = h_256[5];
-        uint32_t g = h_256[6];
-        uint32_t h = h_256[7];
+    state[0] = _mm256_add_epi32(state[0], a);
+    state[1] = _mm256_add_epi32(state[1], b);
+    state[2] = _mm256_add_epi32(state[2], c);
+    state[3] = _mm256_add_epi32(state[3], d);
+    state[4] = _mm256_add_epi32(state[4], e);
+    state[5] = _mm256_add_epi32(state[5], f);
+    state[6] = _mm256_add_epi32(state[6], g);
+    state[7] = _mm256_add_epi32(state[7], h);
+}
 
-        for (int i = 0; i < 64; i++) {
-            uint32_t S1    = ((uint32_t)RIGHT_ROT(e, 6)) ^ ((uint32_t)RIGHT_ROT(e, 11)) ^ ((uint32_t)RIGHT_ROT(e, 25));
-            uint32_t ch    = (e & f) ^ ((~e) & g);
-            uint32_t temp1 = h + S1 + ch + k_256[i] + w[i];
-            uint32_t S0    = ((uint32_t)RIGHT_ROT(a, 2)) ^ ((uint32_t)RIGHT_ROT(a, 13)) ^ ((uint32_t)RIGHT_ROT(a, 22));
-            uint32_t maj   = (a & b) ^ (a & c) ^ (b & c);
-            uint32_t temp2 = S0 + maj;
+    #undef ROTR_X8
+
+__attribute__((target("avx2"))) void HashUtil::SHA256x8AVX2(const uint8_t* const* messages, size_t length,
+                                                            SHA256Digest* digests) {
+    static const uint32_t h_256[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    __m256i state[8];
+    for (size_t j = 0; j < 8; j++)
+        state[j] = _mm256_set1_epi32(static_cast<int32_t>(h_256[j]));
+
+    // full blocks are read in place
+    const uint8_t* blocks[8];
+    size_t nblocks = length / 64;
+    for (size_t n = 0; n < nblocks; n++) {
+        for (size_t i = 0; i < 8; i++)
+            blocks[i] = messages[i] + 64 * n;
+        SHA256CompressX8(state, blocks, k_256);
+    }
 
-            h = g;
-            g = f;
-            f = e;
-            e = d + temp1;
-            d = c;
-            c = b;
-            b = a;
-            a = temp1 + temp2;
-        }
+    // all messages have the same length, hence the same padding layout
+    uint8_t tails[8][128];
+    size_t rem     = length - 64 * nblocks;
+    size_t tailLen = (rem < 56) ? 64 : 128;
+    uint64_t m_len = static_cast<uint64_t>(length) * 8;
+    for (size_t i = 0; i < 8; i++) {
+        std::memset(tails[i], 0, tailLen);
+        std::memcpy(tails[i], messages[i] + 64 * nblocks, rem);
+        tails[i][rem] = 0x80;
+        for (size_t j = 0; j < 8; j++)
+            tails[i][tailLen - 1 - j] = static_cast<uint8_t>(m_len >> (8 * j));
+    }
+    for (size_t n = 0; n < tailLen; n += 64) {
+        for (size_t i = 0; i < 8; i++)
+            blocks[i] = tails[i] + n;
+        SHA256CompressX8(state, blocks, k_256);
+    }
 
-        h_256[0] += a;
-        h_256[1] += b;
-        h_256[2] += c;
-        h_256[3] += d;
-        h_256[4] += e;
-        h_256[5] += f;
-        h_256[6] += g;
-        h_256[7] += h;
+    alignas(32) uint32_t words[8];
+    for (size_t j = 0; j < 8; j++) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(words), state[j]);
+        for (size_t i = 0; i < 8; i++) {
+            digests[i][4 * j]     = static_cast<uint8_t>(words[i] >> 24);
+            digests[i][4 * j + 1] = static_cast<uint8_t>(words[i] >> 16);
+            digests[i][4 * j + 2] = static_cast<uint8_t>(words[i] >> 8);
+            digests[i][4 * j + 3] = static_cast<uint8_t>(words[i]);
+        }
     }
+}
+#else
+void HashUtil::SHA256CompressSHANI(uint32_t* h_256, const uint8_t* blocks, size_t nblocks) {
+    SHA256CompressGeneric(h_256, blocks, nblocks);
+}
 
-    std::stringstream s;
-    s.fill('0');
-    s << std::hex;
-    for (size_t ii = 0; ii < 8; ii++)
-        s << std::setw(8) << h_256[ii];
+void HashUtil::SHA256x8AVX2(const uint8_t* const* messages, size_t length, SHA256Digest* digests) {
+    for (size_t i = 0; i < 8; i++)
+        SHA256Bytes(messages[i], length, digests[i].data());
+}
+#endif
 
-    return s.str();
+void HashUtil::SHA256Multi(const void* const* messages, size_t length, size_t count, SHA256Digest* digests) {
+#if defined(HASHUTIL_X86_DISPATCH)
+    // the SHA extensions hash a single message faster than 8 AVX2 lanes do, so the
+    // multi-buffer path only pays off on CPUs without them
+    static const bool useAVX2 = !CPUHasSHAExtensions() && __builtin_cpu_supports("avx2");
+    if (useAVX2) {
+        SHA256MultiAVX2(messages, length, count, digests);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < count; i++)
+        SHA256Bytes(messages[i], length, digests[i].data());
 }
 
-#if 0
-lbcrypto::BytePlaintextEncoding HashUtil::SHA512(
-    lbcrypto::BytePlaintextEncoding message) {
-  uint64_t h_512[8] = {0x6a09e667f3bcc908, 0xbb67ae8584caa73b,
-                       0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
-                       0x510e527fade682d1, 0x9b05688c2b3e6c1f,
-                       0x1f83d9abfb41bd6b, 0x5be0cd19137e2179};
-
-  uint128_t m_len = message.size() * 8;
-  uint64_t m_len_first = message.size() / (0x2000000000000000);
-  uint64_t m_len_second = message.size() * 8;
-  uint16_t pad_len = 1;
-  while ((m_len + pad_len) % 1024 != 896) {
-    pad_len++;
-  }
-  message.push_back(128);
-  for (int a = 0; a < (pad_len) / 8 - 1; a++) {
-    message.push_back(0);
-  }
-
-  message.push_back((uint8_t)((m_len_first & 0xff00000000000000) >> 56));
-  message.push_back((uint8_t)((m_len_first & 0x00ff000000000000) >> 48));
-  message.push_back((uint8_t)((m_len_first & 0x0000ff0000000000) >> 40));
-  message.push_back((uint8_t)((m_len_first & 0x000000ff00000000) >> 32));
-  message.push_back((uint8_t)((m_len_first & 0x00000000ff000000) >> 24));
-  message.push_back((uint8_t)((m_len_first & 0x0000000000ff0000) >> 16));
-  message.push_back((uint8_t)((m_len_first & 0x000000000000ff00) >> 8));
-  message.push_back((uint8_t)(m_len_first & 0x00000000000000ff));
-
-  message.push_back((uint8_t)((m_len_second & 0xff00000000000000) >> 56));
-  message.push_back((uint8_t)((m_len_second & 0x00ff000000000000) >> 48));
-  message.push_back((uint8_t)((m_len_second & 0x0000ff0000000000) >> 40));
-  message.push_back((uint8_t)((m_len_second & 0x000000ff00000000) >> 32));
-  message.push_back((uint8_t)((m_len_second & 0x00000000ff000000) >> 24));
-  message.push_back((uint8_t)((m_len_second & 0x0000000000ff0000) >> 16));
-  message.push_back((uint8_t)((m_len_second & 0x000000000000ff00) >> 8));
-  message.push_back((uint8_t)(m_len_second & 0x00000000000000ff));
-
-  for (int n = 0; n < (message.size() * 8) / 1024; n++) {
+void HashUtil::SHA256MultiAVX2(const void* const* messages, size_t length, size_t count, SHA256Digest* digests) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8)
+        SHA256x8AVX2(reinterpret_cast<const uint8_t* const*>(messages + i), length, digests + i);
+    for (; i < count; i++)
+        SHA256Bytes(messages[i], length, digests[i].data());
+}
+
+void HashUtil::SHA512Compress(uint64_t* h_512, const uint8_t* block) {
     uint64_t w[80];
-    short counter = 0; // NOLINT
-    for (int m = 128 * n; m < (128 * (n + 1)); m += 8) {
-      w[counter] = ((uint64_t)message.at(m) << 56) ^
-                   ((uint64_t)message.at(m + 1) << 48) ^
-                   ((uint64_t)message.at(m + 2) << 40) ^
-                   ((uint64_t)message.at(m + 3) << 32) ^
-                   ((uint64_t)message.at(m + 4) << 24) ^
-                   ((uint64_t)message.at(m + 5) << 16) ^
-                   ((uint64_t)message.at(m + 6) << 8) ^
-                   ((uint64_t)message.at(m + 7));
-      counter++;
+    for (size_t i = 0; i < 16; i++) {
+        w[i] = 0;
+        for (size_t j = 0; j < 8; j++)
+            w[i] = (w[i] << 8) | block[8 * i + j];
     }
     for (int i = 16; i < 80; i++) {
-      uint64_t s0 = ((uint64_t)RIGHT_ROT(w[i - 15], 1)) ^
-                    ((uint64_t)(RIGHT_ROT(w[i - 15], 8))) ^
-                    ((uint64_t)(w[i - 15] >> 7));
-      uint64_t s1 = ((uint64_t)RIGHT_ROT(w[i - 2], 19)) ^
-                    ((uint64_t)RIGHT_ROT(w[i - 2], 61)) ^
-                    ((uint64_t)(w[i - 2] >> 6));
-      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+        uint64_t s0 = ((uint64_t)RIGHT_ROT(w[i - 15], 1)) ^ ((uint64_t)(RIGHT_ROT(w[i - 15], 8))) ^
+                      ((uint64_t)(w[i - 15] >> 7));
+        uint64_t s1 = ((uint64_t)RIGHT_ROT(w[i - 2], 19)) ^ ((uint64_t)RIGHT_ROT(w[i - 2], 61)) ^
+                      ((uint64_t)(w[i - 2] >> 6));
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
     }
 
     uint64_t a = h_512[0];
@@ -311,23 +401,21 @@ lbcrypto::BytePlaintextEncoding HashUtil::SHA512(
     uint64_t h = h_512[7];
 
     for (int i = 0; i < 80; i++) {
-      uint64_t S1 = ((uint64_t)RIGHT_ROT(e, 14)) ^
-                    ((uint64_t)RIGHT_ROT(e, 18)) ^ ((uint64_t)RIGHT_ROT(e, 41));
-      uint64_t ch = (e & f) ^ ((~e) & g);
-      uint64_t temp1 = h + S1 + ch + k_512[i] + w[i];
-      uint64_t S0 = ((uint64_t)RIGHT_ROT(a, 28)) ^
-                    ((uint64_t)RIGHT_ROT(a, 34)) ^ ((uint64_t)RIGHT_ROT(a, 39));
-      uint64_t maj = (a & b) ^ (a & c) ^ (b & c);
-      uint64_t temp2 = S0 + maj;
-
-      h = g;
-      g = f;
-      f = e;
-      e = d + temp1;
-      d = c;
-      c = b;
-      b = a;
-      a = temp1 + temp2;
+        uint64_t S1    = ((uint64_t)RIGHT_ROT(e, 14)) ^ ((uint64_t)RIGHT_ROT(e, 18)) ^ ((uint64_t)RIGHT_ROT(e, 41));
+        uint64_t ch    = (e & f) ^ ((~e) & g);
+        uint64_t temp1 = h + S1 + ch + k_512[i] + w[i];
+        uint64_t S0    = ((uint64_t)RIGHT_ROT(a, 28)) ^ ((uint64_t)RIGHT_ROT(a, 34)) ^ ((uint64_t)RIGHT_ROT(a, 39));
+        uint64_t maj   = (a & b) ^ (a & c) ^ (b & c);
+        uint64_t temp2 = S0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
     }
 
     h_512[0] += a;
@@ -338,22 +426,114 @@ lbcrypto::BytePlaintextEncoding HashUtil::SHA512(
     h_512[5] += f;
     h_512[6] += g;
     h_512[7] += h;
-  }
-
-  lbcrypto::BytePlaintextEncoding digest;
-  for (int i = 0; i < 8; i++) {
-    digest.push_back((uint8_t)((h_512[i] & 0xff00000000000000) >> 56));
-    digest.push_back((uint8_t)((h_512[i] & 0x00ff000000000000) >> 48));
-    digest.push_back((uint8_t)((h_512[i] & 0x0000ff0000000000) >> 40));
-    digest.push_back((uint8_t)((h_512[i] & 0x000000ff00000000) >> 32));
-    digest.push_back((uint8_t)((h_512[i] & 0x00000000ff000000) >> 24));
-    digest.push_back((uint8_t)((h_512[i] & 0x0000000000ff0000) >> 16));
-    digest.push_back((uint8_t)((h_512[i] & 0x000000000000ff00) >> 8));
-    digest.push_back((uint8_t)(h_512[i] & 0x00000000000000ff));
-  }
-
-  return digest;
 }
-#endif
+
+void HashUtil::SHA512Bytes(const void* message, size_t length, uint8_t* digest) {
+    uint64_t h_512[8] = {0x6a09e667f3bcc908, 0xbb67ae8584caa73b, 0x3c6ef372fe94f82b, 0xa54ff53a5f1d36f1,
+                         0x510e527fade682d1, 0x9b05688c2b3e6c1f, 0x1f83d9abfb41bd6b, 0x5be0cd19137e2179};
+
+    const uint8_t* in = static_cast<const uint8_t*>(message);
+    size_t nblocks    = length / 128;
+    for (size_t n = 0; n < nblocks; n++)
+        SHA512Compress(h_512, in + 128 * n);
+
+    // the message length is encoded on 128 bits
+    uint8_t tail[256] = {0};
+    size_t rem        = length - 128 * nblocks;
+    std::memcpy(tail, in + 128 * nblocks, rem);
+    tail[rem]            = 0x80;
+    size_t tailLen       = (rem < 112) ? 128 : 256;
+    uint64_t m_len_low   = static_cast<uint64_t>(length) << 3;
+    uint64_t m_len_high  = static_cast<uint64_t>(length) >> 61;
+    for (size_t i = 0; i < 8; i++) {
+        tail[tailLen - 1 - i] = static_cast<uint8_t>(m_len_low >> (8 * i));
+        tail[tailLen - 9 - i] = static_cast<uint8_t>(m_len_high >> (8 * i));
+    }
+    for (size_t n = 0; n < tailLen; n += 128)
+        SHA512Compress(h_512, tail + n);
+
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t j = 0; j < 8; j++)
+            digest[8 * i + j] = static_cast<uint8_t>(h_512[i] >> (56 - 8 * j));
+    }
+}
+
+void HashUtil::SHA512(const std::string& message, std::vector<int64_t>& digest) {
+    SHA512Digest bytes;
+    SHA512Bytes(message.data(), message.size(), bytes.data());
+    digest.insert(digest.end(), bytes.begin(), bytes.end());
+}
+
+void SHA256Hasher::Init() {
+    static const uint32_t h_256[8] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                      0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+    std::memcpy(m_state, h_256, sizeof(m_state));
+    m_bufferLen = 0;
+    m_length    = 0;
+}
+
+void SHA256Hasher::Update(const void* data, size_t length) {
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    m_length += length;
+
+    if (m_bufferLen > 0) {
+        size_t take = std::min(length, sizeof(m_buffer) - m_bufferLen);
+        std::memcpy(m_buffer + m_bufferLen, in, take);
+        m_bufferLen += take;
+        in += take;
+        length -= take;
+        if (m_bufferLen < sizeof(m_buffer))
+            return;
+        HashUtil::SHA256Compress(m_state, m_buffer, 1);
+        m_bufferLen = 0;
+    }
+
+    // full blocks are compressed straight from the caller's buffer
+    size_t nblocks = length / 64;
+    if (nblocks > 0) {
+        HashUtil::SHA256Compress(m_state, in, nblocks);
+        in += 64 * nblocks;
+        length -= 64 * nblocks;
+    }
+
+    std::memcpy(m_buffer, in, length);
+    m_bufferLen = length;
+}
+
+void SHA256Hasher::Final(uint8_t* digest) {
+    uint64_t m_len = m_length * 8;
+
+    m_buffer[m_bufferLen++] = 0x80;
+    if (m_bufferLen > 56) {
+        std::memset(m_buffer + m_bufferLen, 0, sizeof(m_buffer) - m_bufferLen);
+        HashUtil::SHA256Compress(m_state, m_buffer, 1);
+        m_bufferLen = 0;
+    }
+    std::memset(m_buffer + m_bufferLen, 0, 56 - m_bufferLen);
+    for (size_t i = 0; i < 8; i++)
+        m_buffer[63 - i] = static_cast<uint8_t>(m_len >> (8 * i));
+    HashUtil::SHA256Compress(m_state, m_buffer, 1);
+
+    for (size_t i = 0; i < 8; i++) {
+        digest[4 * i]     = static_cast<uint8_t>(m_state[i] >> 24);
+        digest[4 * i + 1] = static_cast<uint8_t>(m_state[i] >> 16);
+        digest[4 * i + 2] = static_cast<uint8_t>(m_state[i] >> 8);
+        digest[4 * i + 3] = static_cast<uint8_t>(m_state[i]);
+    }
+    Init();
+}
+
+std::string HashUtil::HashString(const std::string& message) {
+    SHA256Digest digest;
+    SHA256Bytes(message.data(), message.size(), digest.data());
+
+    std::stringstream s;
+    s.fill('0');
+    s << std::hex;
+    for (auto byte : digest)
+        s << std::setw(2) << static_cast<uint32_t>(byte);
+
+    return s.str();
+}
 
 }  // namespace lbcrypto
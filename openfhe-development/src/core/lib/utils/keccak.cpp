@@ -0,0 +1,341 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Keccak-f[1600] permutation and the FIPS 202 sponges (SHA3-256, SHA3-512, SHAKE128, SHAKE256)
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "utils/hashutil.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    #include <immintrin.h>
+    #define KECCAK_X86_DISPATCH
+#endif
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr uint64_t KECCAK_RC[24] = {
+    0x0000000000000001, 0x0000000000008082, 0x800000000000808a, 0x8000000080008000, 0x000000000000808b,
+    0x0000000080000001, 0x8000000080008081, 0x8000000000008009, 0x000000000000008a, 0x0000000000000088,
+    0x0000000080008009, 0x000000008000000a, 0x000000008000808b, 0x800000000000008b, 0x8000000000008089,
+    0x8000000000008003, 0x8000000000008002, 0x8000000000000080, 0x000000000000800a, 0x800000008000000a,
+    0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008};
+
+// rotation offsets of lane x + 5y
+constexpr unsigned KECCAK_RHO[25] = {0,  1,  62, 28, 27, 36, 44, 6,  55, 20, 3,  10, 43,
+                                 25, 39, 41, 45, 15, 21, 8,  18, 2,  61, 56, 14};
+
+inline uint64_t ROTL64(uint64_t x, unsigned n) {
+    return (n == 0) ? x : ((x << n) | (x >> (64 - n)));
+}
+
+inline uint64_t LoadLE64(const uint8_t* in) {
+    uint64_t w = 0;
+    for (size_t i = 0; i < 8; i++)
+        w |= static_cast<uint64_t>(in[i]) << (8 * i);
+    return w;
+}
+
+inline void StoreLE64(uint8_t* out, uint64_t w) {
+    for (size_t i = 0; i < 8; i++)
+        out[i] = static_cast<uint8_t>(w >> (8 * i));
+}
+
+void KeccakParameters(HashAlgorithm algo, size_t& rate, uint8_t& domain) {
+    switch (algo) {
+        case SHA3_256:
+            rate   = 136;
+            domain = 0x06;
+            return;
+        case SHA3_512:
+            rate   = 72;
+            domain = 0x06;
+            return;
+        case SHAKE_128:
+            rate   = 168;
+            domain = 0x1F;
+            return;
+        case SHAKE_256:
+            rate   = 136;
+            domain = 0x1F;
+            return;
+        default:
+            OPENFHE_THROW("ERROR: Hash Algorithm is not a Keccak sponge");
+    }
+}
+
+#if defined(KECCAK_X86_DISPATCH)
+    #define ROTL_X4(x, n) _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - (n)))
+
+__attribute__((target("avx2"))) void KeccakF1600x4AVX2(uint64_t* state) {
+    __m256i A[25];
+    __m256i B[25];
+    __m256i C[5];
+    __m256i D[5];
+    for (size_t i = 0; i < 25; i++)
+        A[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(state + 4 * i));
+
+    for (size_t round = 0; round < 24; round++) {
+    #pragma GCC unroll 5
+        for (size_t x = 0; x < 5; x++)
+            C[x] = _mm256_xor_si256(_mm256_xor_si256(A[x], A[x + 5]),
+                                    _mm256_xor_si256(_mm256_xor_si256(A[x + 10], A[x + 15]), A[x + 20]));
+    #pragma GCC unroll 5
+        for (size_t x = 0; x < 5; x++)
+            D[x] = _mm256_xor_si256(C[(x + 4) % 5], ROTL_X4(C[(x + 1) % 5], 1));
+
+        // theta, rho and pi: lane (x, y) moves to (y, 2x + 3y)
+    #pragma GCC unroll 25
+        for (size_t i = 0; i < 25; i++) {
+            size_t x   = i % 5;
+            size_t y   = i / 5;
+            __m256i a  = _mm256_xor_si256(A[i], D[x]);
+            size_t dst = y + 5 * ((2 * x + 3 * y) % 5);
+            B[dst]     = (KECCAK_RHO[i] == 0) ? a : ROTL_X4(a, KECCAK_RHO[i]);
+        }
+
+        // chi and iota
+    #pragma GCC unroll 5
+        for (size_t y = 0; y < 25; y += 5) {
+    #pragma GCC unroll 5
+            for (size_t x = 0; x < 5; x++)
+                A[y + x] = _mm256_xor_si256(B[y + x], _mm256_andnot_si256(B[y + (x + 1) % 5], B[y + (x + 2) % 5]));
+        }
+        A[0] = _mm256_xor_si256(A[0], _mm256_set1_epi64x(static_cast<int64_t>(KECCAK_RC[round])));
+    }
+
+    for (size_t i = 0; i < 25; i++)
+        _mm256_store_si256(reinterpret_cast<__m256i*>(state + 4 * i), A[i]);
+}
+
+    #undef ROTL_X4
+#endif
+
+}  // namespace
+
+void HashUtil::KeccakF1600(uint64_t* state) {
+    uint64_t B[25];
+    uint64_t C[5];
+    uint64_t D[5];
+
+    for (size_t round = 0; round < 24; round++) {
+#pragma GCC unroll 5
+        for (size_t x = 0; x < 5; x++)
+            C[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+#pragma GCC unroll 5
+        for (size_t x = 0; x < 5; x++)
+            D[x] = C[(x + 4) % 5] ^ ROTL64(C[(x + 1) % 5], 1);
+
+        // theta, rho and pi: lane (x, y) moves to (y, 2x + 3y)
+#pragma GCC unroll 25
+        for (size_t i = 0; i < 25; i++) {
+            size_t x                         = i % 5;
+            size_t y                         = i / 5;
+            B[y + 5 * ((2 * x + 3 * y) % 5)] = ROTL64(state[i] ^ D[x], KECCAK_RHO[i]);
+        }
+
+        // chi and iota
+#pragma GCC unroll 5
+        for (size_t y = 0; y < 25; y += 5) {
+#pragma GCC unroll 5
+            for (size_t x = 0; x < 5; x++)
+                state[y + x] = B[y + x] ^ ((~B[y + (x + 1) % 5]) & B[y + (x + 2) % 5]);
+        }
+        state[0] ^= KECCAK_RC[round];
+    }
+}
+
+void HashUtil::KeccakF1600x4(uint64_t* state) {
+#if defined(KECCAK_X86_DISPATCH)
+    static const bool useAVX2 = __builtin_cpu_supports("avx2");
+    if (useAVX2) {
+        KeccakF1600x4AVX2(state);
+        return;
+    }
+#endif
+    uint64_t single[25];
+    for (size_t j = 0; j < 4; j++) {
+        for (size_t i = 0; i < 25; i++)
+            single[i] = state[4 * i + j];
+        KeccakF1600(single);
+        for (size_t i = 0; i < 25; i++)
+            state[4 * i + j] = single[i];
+    }
+}
+
+KeccakHasher::KeccakHasher(HashAlgorithm algo) {
+    KeccakParameters(algo, m_rate, m_domain);
+    Init();
+}
+
+void KeccakHasher::Init() {
+    std::memset(m_state, 0, sizeof(m_state));
+    m_pos       = 0;
+    m_squeezing = false;
+}
+
+void KeccakHasher::Update(const void* data, size_t length) {
+    if (m_squeezing)
+        OPENFHE_THROW("KeccakHasher::Update called after Squeeze; call Init first");
+
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+
+    // complete a partially absorbed block byte by byte
+    while (length > 0 && m_pos % 8 != 0) {
+        m_state[m_pos / 8] ^= static_cast<uint64_t>(*in++) << (8 * (m_pos % 8));
+        length--;
+        if (++m_pos == m_rate) {
+            HashUtil::KeccakF1600(m_state);
+            m_pos = 0;
+        }
+    }
+
+    // whole words
+    while (length >= 8) {
+        m_state[m_pos / 8] ^= LoadLE64(in);
+        in += 8;
+        length -= 8;
+        m_pos += 8;
+        if (m_pos == m_rate) {
+            HashUtil::KeccakF1600(m_state);
+            m_pos = 0;
+        }
+    }
+
+    // m_rate is a multiple of 8, so the remaining bytes never fill the block
+    for (; length > 0; length--, m_pos++)
+        m_state[m_pos / 8] ^= static_cast<uint64_t>(*in++) << (8 * (m_pos % 8));
+}
+
+void KeccakHasher::Squeeze(uint8_t* out, size_t length) {
+    if (!m_squeezing) {
+        m_state[m_pos / 8] ^= static_cast<uint64_t>(m_domain) << (8 * (m_pos % 8));
+        m_state[(m_rate - 1) / 8] ^= static_cast<uint64_t>(0x80) << (8 * ((m_rate - 1) % 8));
+        HashUtil::KeccakF1600(m_state);
+        m_pos       = 0;
+        m_squeezing = true;
+    }
+
+    while (length > 0) {
+        if (m_pos == m_rate) {
+            HashUtil::KeccakF1600(m_state);
+            m_pos = 0;
+        }
+        size_t take = std::min(length, m_rate - m_pos);
+        for (size_t i = 0; i < take; i++, m_pos++)
+            out[i] = static_cast<uint8_t>(m_state[m_pos / 8] >> (8 * (m_pos % 8)));
+        out += take;
+        length -= take;
+    }
+}
+
+KeccakHasherX4::KeccakHasherX4(HashAlgorithm algo) {
+    KeccakParameters(algo, m_rate, m_domain);
+    std::memset(m_state, 0, sizeof(m_state));
+}
+
+void KeccakHasherX4::Absorb(const void* const* messages, size_t length) {
+    std::memset(m_state, 0, sizeof(m_state));
+
+    const uint8_t* in[4];
+    for (size_t j = 0; j < 4; j++)
+        in[j] = static_cast<const uint8_t*>(messages[j]);
+
+    size_t offset = 0;
+    for (; length - offset >= m_rate; offset += m_rate) {
+        for (size_t i = 0; i < m_rate / 8; i++) {
+            for (size_t j = 0; j < 4; j++)
+                m_state[4 * i + j] ^= LoadLE64(in[j] + offset + 8 * i);
+        }
+        HashUtil::KeccakF1600x4(m_state);
+    }
+
+    // the last partial block is padded in place
+    uint8_t block[200];
+    size_t rem = length - offset;
+    for (size_t j = 0; j < 4; j++) {
+        std::memset(block, 0, m_rate);
+        std::memcpy(block, in[j] + offset, rem);
+        block[rem] = m_domain;
+        block[m_rate - 1] |= 0x80;
+        for (size_t i = 0; i < m_rate / 8; i++)
+            m_state[4 * i + j] ^= LoadLE64(block + 8 * i);
+    }
+}
+
+void KeccakHasherX4::SqueezeBlocks(uint8_t* const* outputs, size_t nblocks) {
+    for (size_t n = 0; n < nblocks; n++) {
+        HashUtil::KeccakF1600x4(m_state);
+        for (size_t i = 0; i < m_rate / 8; i++) {
+            for (size_t j = 0; j < 4; j++)
+                StoreLE64(outputs[j] + n * m_rate + 8 * i, m_state[4 * i + j]);
+        }
+    }
+}
+
+void HashUtil::SHA3_256Bytes(const void* message, size_t length, uint8_t* digest) {
+    KeccakHasher hasher(SHA3_256);
+    hasher.Update(message, length);
+    hasher.Squeeze(digest, 32);
+}
+
+void HashUtil::SHA3_512Bytes(const void* message, size_t length, uint8_t* digest) {
+    KeccakHasher hasher(SHA3_512);
+    hasher.Update(message, length);
+    hasher.Squeeze(digest, 64);
+}
+
+void HashUtil::SHAKE128(const void* message, size_t length, uint8_t* out, size_t outLength) {
+    KeccakHasher hasher(SHAKE_128);
+    hasher.Update(message, length);
+    hasher.Squeeze(out, outLength);
+}
+
+void HashUtil::SHAKE256(const void* message, size_t length, uint8_t* out, size_t outLength) {
+    KeccakHasher hasher(SHAKE_256);
+    hasher.Update(message, length);
+    hasher.Squeeze(out, outLength);
+}
+
+void HashUtil::Keccak(const std::string& message, HashAlgorithm algo, std::vector<int64_t>& digest) {
+    size_t outLength = (algo == SHA3_256 || algo == SHAKE_128) ? 32 : 64;
+    uint8_t out[64];
+    KeccakHasher hasher(algo);
+    hasher.Update(message.data(), message.size());
+    hasher.Squeeze(out, outLength);
+    digest.insert(digest.end(), out, out + outLength);
+}
+
+}  // namespace lbcrypto
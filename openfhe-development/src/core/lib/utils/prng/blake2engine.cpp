@@ -33,7 +33,9 @@
 #include "utils/exception.h"
 #include "utils/memory.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <random>
 #include <thread>
 
@@ -48,13 +50,43 @@ Blake2Engine::~Blake2Engine() {
 void Blake2Engine::Generate() {
     // m_counter is the input to the hash function
     // m_buffer is the output
-    if (blake2xb(m_buffer.begin(), m_buffer.size() * sizeof(PRNG::result_type), &m_counter, sizeof(m_counter),
-                 m_seed.cbegin(), m_seed.size() * sizeof(PRNG::result_type)) != 0) {
+    if (blake2xb_x4(m_buffer.begin(), m_buffer.size() * sizeof(PRNG::result_type), &m_counter, sizeof(m_counter),
+                    m_seed.cbegin(), m_seed.size() * sizeof(PRNG::result_type)) != 0) {
         OPENFHE_THROW("PRNG: blake2xb failed");
     }
     m_counter++;
 }
 
+void Blake2Engine::Fill(void* buffer, size_t nbytes) {
+    constexpr size_t BUFFER_BYTES = PRNG_BUFFER_SIZE * sizeof(PRNG::result_type);
+    uint8_t* out                  = static_cast<uint8_t*>(buffer);
+
+    // values left in the current buffer; the stream is the same as for operator()
+    if (m_bufferIndex != 0 && m_bufferIndex < static_cast<size_t>(PRNG_BUFFER_SIZE)) {
+        size_t bytes = std::min(nbytes, (PRNG_BUFFER_SIZE - m_bufferIndex) * sizeof(PRNG::result_type));
+        std::memcpy(out, m_buffer.data() + m_bufferIndex, bytes);
+        m_bufferIndex += (bytes + sizeof(PRNG::result_type) - 1) / sizeof(PRNG::result_type);
+        out += bytes;
+        nbytes -= bytes;
+    }
+
+    // whole buffers skip the copy through m_buffer
+    for (; nbytes >= BUFFER_BYTES; out += BUFFER_BYTES, nbytes -= BUFFER_BYTES) {
+        if (blake2xb_x4(out, BUFFER_BYTES, &m_counter, sizeof(m_counter), m_seed.cbegin(),
+                        m_seed.size() * sizeof(PRNG::result_type)) != 0) {
+            OPENFHE_THROW("PRNG: blake2xb failed");
+        }
+        m_counter++;
+        m_bufferIndex = PRNG_BUFFER_SIZE;
+    }
+
+    if (nbytes > 0) {
+        Generate();
+        std::memcpy(out, m_buffer.data(), nbytes);
+        m_bufferIndex = (nbytes + sizeof(PRNG::result_type) - 1) / sizeof(PRNG::result_type);
+    }
+}
+
 extern "C" {
 // if FIXED_SEED is defined, then PRNG uses a fixed seed number for reproducible results during debug.
 // Use only one OMP thread to ensure reproducibility
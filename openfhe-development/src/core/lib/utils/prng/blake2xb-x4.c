@@ -0,0 +1,194 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2024, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+/*
+  BLAKE2Xb with the output blocks computed four at a time. Every 64-byte output block of BLAKE2Xb
+  is an independent single-block BLAKE2b of the root hash that differs only in node_offset (and in
+  digest_length for a short last block), so the AVX2 kernel keeps four such states in the 64-bit
+  lanes of __m256i. The output is byte-for-byte identical to blake2xb().
+ */
+#include "utils/prng/blake2.h"
+#include "utils/prng/blake2-impl.h"
+
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    #define BLAKE2XB_X4_AVX2
+    #include <immintrin.h>
+#endif
+
+#if defined(BLAKE2XB_X4_AVX2)
+
+static const uint64_t blake2xb_x4_IV[8] = {0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL,
+                                           0xa54ff53a5f1d36f1ULL, 0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL,
+                                           0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL};
+
+static const uint8_t blake2xb_x4_sigma[12][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3},
+    {11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4}, {7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8},
+    {9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13}, {2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9},
+    {12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11}, {13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10},
+    {6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5}, {10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, {14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3}};
+
+    #define ROTR32_X4(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+    #define ROTR24_X4(x) _mm256_shuffle_epi8((x), r24)
+    #define ROTR16_X4(x) _mm256_shuffle_epi8((x), r16)
+    #define ROTR63_X4(x) _mm256_or_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+    #define G_X4(r, i, a, b, c, d)                                                           \
+        do {                                                                                 \
+            a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2xb_x4_sigma[r][2 * i + 0]]); \
+            d = ROTR32_X4(_mm256_xor_si256(d, a));                                           \
+            c = _mm256_add_epi64(c, d);                                                      \
+            b = ROTR24_X4(_mm256_xor_si256(b, c));                                           \
+            a = _mm256_add_epi64(_mm256_add_epi64(a, b), m[blake2xb_x4_sigma[r][2 * i + 1]]); \
+            d = ROTR16_X4(_mm256_xor_si256(d, a));                                           \
+            c = _mm256_add_epi64(c, d);                                                      \
+            b = ROTR63_X4(_mm256_xor_si256(b, c));                                           \
+        } while (0)
+
+/*
+  Computes output blocks [first, first + 4) of BLAKE2Xb, i.e. blake2b(root) under the parameter
+  blocks P[0..3]. The message is the 64-byte root padded with zeros; it is the last block, so
+  t = 64 and f0 = ~0.
+ */
+__attribute__((target("avx2"))) static void blake2xb_x4_blocks(const blake2b_param P[4],
+                                                               const uint8_t root[BLAKE2B_OUTBYTES],
+                                                               uint64_t out[8][4]) {
+    const __m256i r24 =
+        _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14,
+                         15, 8, 9, 10);
+    const __m256i r16 =
+        _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13,
+                         14, 15, 8, 9);
+    __m256i m[16];
+    __m256i h[8];
+    __m256i v[16];
+    size_t i;
+    int r;
+
+    for (i = 0; i < 8; ++i) {
+        m[i]     = _mm256_set1_epi64x((long long)load64(root + 8 * i));
+        m[i + 8] = _mm256_setzero_si256();
+    }
+    for (i = 0; i < 8; ++i) {
+        h[i] = _mm256_setr_epi64x((long long)(blake2xb_x4_IV[i] ^ load64((const uint8_t*)&P[0] + 8 * i)),
+                                  (long long)(blake2xb_x4_IV[i] ^ load64((const uint8_t*)&P[1] + 8 * i)),
+                                  (long long)(blake2xb_x4_IV[i] ^ load64((const uint8_t*)&P[2] + 8 * i)),
+                                  (long long)(blake2xb_x4_IV[i] ^ load64((const uint8_t*)&P[3] + 8 * i)));
+        v[i] = h[i];
+    }
+    for (i = 0; i < 8; ++i)
+        v[i + 8] = _mm256_set1_epi64x((long long)blake2xb_x4_IV[i]);
+    v[12] = _mm256_set1_epi64x((long long)(blake2xb_x4_IV[4] ^ BLAKE2B_OUTBYTES));
+    v[14] = _mm256_set1_epi64x((long long)~blake2xb_x4_IV[6]);
+
+    for (r = 0; r < 12; ++r) {
+        G_X4(r, 0, v[0], v[4], v[8], v[12]);
+        G_X4(r, 1, v[1], v[5], v[9], v[13]);
+        G_X4(r, 2, v[2], v[6], v[10], v[14]);
+        G_X4(r, 3, v[3], v[7], v[11], v[15]);
+        G_X4(r, 4, v[0], v[5], v[10], v[15]);
+        G_X4(r, 5, v[1], v[6], v[11], v[12]);
+        G_X4(r, 6, v[2], v[7], v[8], v[13]);
+        G_X4(r, 7, v[3], v[4], v[9], v[14]);
+    }
+
+    for (i = 0; i < 8; ++i)
+        _mm256_storeu_si256((__m256i*)out[i], _mm256_xor_si256(h[i], _mm256_xor_si256(v[i], v[i + 8])));
+}
+
+    #undef G_X4
+    #undef ROTR32_X4
+    #undef ROTR24_X4
+    #undef ROTR16_X4
+    #undef ROTR63_X4
+
+static int blake2xb_x4_avx2(void* out, size_t outlen, const void* in, size_t inlen, const void* key, size_t keylen) {
+    blake2xb_state S[1];
+    blake2b_param P[4];
+    uint8_t root[BLAKE2B_OUTBYTES];
+    uint64_t words[8][4];
+    uint8_t block[BLAKE2B_OUTBYTES];
+    size_t first, lane, j;
+
+    if (blake2xb_init_key(S, outlen, key, keylen) < 0)
+        return -1;
+    blake2xb_update(S, in, inlen);
+    if (blake2b_final(S->S, root, BLAKE2B_OUTBYTES) < 0)
+        return -1;
+
+    /* same parameter block as blake2xb_final */
+    memcpy(&P[0], S->P, sizeof(blake2b_param));
+    P[0].key_length = 0;
+    P[0].fanout     = 0;
+    P[0].depth      = 0;
+    store32(&P[0].leaf_length, BLAKE2B_OUTBYTES);
+    P[0].inner_length = BLAKE2B_OUTBYTES;
+    P[0].node_depth   = 0;
+    P[1] = P[2] = P[3] = P[0];
+
+    for (first = 0; first * BLAKE2B_OUTBYTES < outlen; first += 4) {
+        for (lane = 0; lane < 4; ++lane) {
+            const size_t offset = (first + lane) * BLAKE2B_OUTBYTES;
+            const size_t left   = (offset < outlen) ? outlen - offset : 0;
+            P[lane].digest_length = (uint8_t)((left < BLAKE2B_OUTBYTES) ? left : BLAKE2B_OUTBYTES);
+            store32(&P[lane].node_offset, (uint32_t)(first + lane));
+        }
+        blake2xb_x4_blocks(P, root, words);
+        for (lane = 0; lane < 4 && P[lane].digest_length > 0; ++lane) {
+            for (j = 0; j < 8; ++j)
+                store64(block + 8 * j, words[j][lane]);
+            memcpy((uint8_t*)out + (first + lane) * BLAKE2B_OUTBYTES, block, P[lane].digest_length);
+        }
+    }
+
+    secure_zero_memory(root, sizeof(root));
+    secure_zero_memory(block, sizeof(block));
+    secure_zero_memory(words, sizeof(words));
+    secure_zero_memory(S, sizeof(S));
+    return 0;
+}
+
+#endif  // BLAKE2XB_X4_AVX2
+
+int blake2xb_x4(void* out, size_t outlen, const void* in, size_t inlen, const void* key, size_t keylen) {
+    /* same argument checks as blake2xb */
+    if ((NULL == in && inlen > 0) || NULL == out || (NULL == key && keylen > 0) || keylen > BLAKE2B_KEYBYTES ||
+        outlen == 0)
+        return -1;
+
+#if defined(BLAKE2XB_X4_AVX2)
+    if (__builtin_cpu_supports("avx2"))
+        return blake2xb_x4_avx2(out, outlen, in, inlen, key, keylen);
+#endif
+    return blake2xb(out, outlen, in, inlen, key, keylen);
+}
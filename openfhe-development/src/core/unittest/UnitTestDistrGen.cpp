@@ -43,6 +43,8 @@
 #include "math/nbtheory.h"
 #include "utils/debug.h"
 #include "utils/inttypes.h"
+#include "utils/prng/blake2.h"
+#include "utils/prng/blake2engine.h"
 #include "utils/utilities.h"
 
 #include "testdefs.h"
@@ -650,3 +652,156 @@ TEST(UTDistrGen, ThreadSafetyInGetPRNG) {
     RUN_ALL_BACKENDS(ThreadSafetyInGetPRNG, "Thread safety in getPRNG")
 }
 #endif
+
+// The CDT sampler must match the analytic distribution for small deviations
+template <typename V>
+void CDT_Distribution(const std::string& msg) {
+    double stdev = 2.3;
+    usint size   = 200000;
+    auto dgg     = DiscreteGaussianGeneratorImpl<V>(stdev, CDT_CONSTANT_TIME);
+    EXPECT_EQ(dgg.GetSamplingMethod(), CDT_CONSTANT_TIME) << msg;
+
+    std::vector<int32_t> samples(size);
+    dgg.GenerateIntVector(samples.data(), size);
+
+    double mean = 0, variance = 0;
+    std::vector<usint> counts(41, 0);
+    for (auto x : samples) {
+        mean += x;
+        variance += static_cast<double>(x) * x;
+        ASSERT_LE(std::abs(x), 20) << msg << " sample outside the table support";
+        counts[x + 20]++;
+    }
+    mean /= size;
+    variance /= size;
+    EXPECT_LE(std::abs(mean), 0.05) << msg << " Failure CDT mean";
+    EXPECT_LE(std::abs(variance - stdev * stdev) / (stdev * stdev), 0.02) << msg << " Failure CDT variance";
+
+    // Pr[x = 0] = 1 / sum_x exp(-x^2 / (2 stdev^2))
+    double norm = 0;
+    for (int x = -20; x <= 20; ++x)
+        norm += std::exp(-x * x / (2 * stdev * stdev));
+    EXPECT_NEAR(static_cast<double>(counts[20]) / size, 1 / norm, 0.005) << msg << " Failure CDT Pr[0]";
+    EXPECT_NEAR(static_cast<double>(counts[21]) / size, counts[19] / static_cast<double>(size), 0.005)
+        << msg << " Failure CDT symmetry";
+
+    // the other entry points draw from the same table
+    for (usint i = 0; i < 1000; i++)
+        ASSERT_LE(std::abs(dgg.GenerateInt()), 20) << msg;
+
+    EXPECT_THROW(DiscreteGaussianGeneratorImpl<V>(2 * KARNEY_THRESHOLD, CDT_CONSTANT_TIME), OpenFHEException) << msg;
+}
+
+TEST(UTDistrGen, CDT_Distribution) {
+    RUN_ALL_BACKENDS(CDT_Distribution, "CDT_Distribution")
+}
+
+// sampling from a caller-supplied engine must be reproducible from its seed
+template <typename V>
+void DGG_GenerateIntVector_with_engine(const std::string& msg) {
+    const size_t size = 1000;
+    // CDT, inversion and (above the threshold) Karney
+    const std::vector<std::pair<double, GaussianSamplingMethod>> cases{
+        {3.19, CDT_CONSTANT_TIME}, {3.19, PEIKERT_INVERSION}, {2 * KARNEY_THRESHOLD, PEIKERT_INVERSION}};
+    for (const auto& [stddev, method] : cases) {
+        auto dgg = DiscreteGaussianGeneratorImpl<V>(stddev, method);
+
+        default_prng::Blake2Engine::blake2_seed_array_t seed{};
+        seed[0] = 11;
+        default_prng::Blake2Engine g1(seed, 0), g2(seed, 0);
+        seed[0] = 12;
+        default_prng::Blake2Engine g3(seed, 0);
+
+        std::vector<int32_t> a(size), b(size), c(size);
+        dgg.GenerateIntVector(g1, a.data(), size);
+        dgg.GenerateIntVector(g2, b.data(), size);
+        dgg.GenerateIntVector(g3, c.data(), size);
+        EXPECT_EQ(a, b) << msg << " same seed, different samples";
+        EXPECT_NE(a, c) << msg << " different seeds, same samples";
+    }
+}
+
+TEST(UTDistrGen, DGG_GenerateIntVector_with_engine) {
+    RUN_ALL_BACKENDS(DGG_GenerateIntVector_with_engine, "DGG_GenerateIntVector_with_engine")
+}
+
+// Fill must return the same stream as repeated calls to operator()
+TEST(UTDistrGen, Blake2Engine_Fill_matches_operator) {
+    default_prng::Blake2Engine::blake2_seed_array_t seed{};
+    seed[0] = 7;
+    default_prng::Blake2Engine bulk(seed, 0);
+    default_prng::Blake2Engine single(seed, 0);
+
+    // sizes around the 4096-byte internal buffer, including partial words
+    for (size_t nbytes : {4, 3, 100, 4096, 5000, 1, 12288, 4093}) {
+        std::vector<uint8_t> a(nbytes), b(nbytes);
+        bulk.Fill(a.data(), nbytes);
+        single.PRNG::Fill(b.data(), nbytes);
+        EXPECT_EQ(a, b) << "Fill of " << nbytes << " bytes";
+    }
+    EXPECT_EQ(bulk(), single());
+}
+
+// the four-lane BLAKE2Xb must reproduce the reference output for every length
+TEST(UTDistrGen, Blake2xb_x4_matches_reference) {
+    std::vector<uint8_t> key(64), in(100);
+    for (size_t i = 0; i < key.size(); i++)
+        key[i] = static_cast<uint8_t>(3 * i + 1);
+    for (size_t i = 0; i < in.size(); i++)
+        in[i] = static_cast<uint8_t>(i);
+
+    for (size_t outlen : {1, 31, 64, 65, 200, 255, 256, 257, 1000, 4096, 4100}) {
+        for (size_t keylen : {0, 16, 64}) {
+            std::vector<uint8_t> ref(outlen), x4(outlen);
+            const void* k = keylen ? key.data() : nullptr;
+            ASSERT_EQ(blake2xb(ref.data(), outlen, in.data(), in.size(), k, keylen), 0);
+            ASSERT_EQ(blake2xb_x4(x4.data(), outlen, in.data(), in.size(), k, keylen), 0);
+            EXPECT_EQ(ref, x4) << "outlen " << outlen << ", keylen " << keylen;
+        }
+    }
+}
+
+template <typename V>
+void BulkGenerators(const std::string& msg) {
+    usint size = 100000;
+
+    // DUG: mask-and-reject for a small, a 32-bit and a 60-bit modulus
+    for (const char* q : {"3329", "4294967291", "1152921504606830593"}) {
+        typename V::Integer modulus(q);
+        DiscreteUniformGeneratorImpl<V> dug(modulus);
+        V v = dug.GenerateVector(size);
+        double mean = 0;
+        for (usint i = 0; i < size; i++) {
+            ASSERT_LT(v[i], modulus) << msg;
+            mean += v[i].ConvertToDouble() / modulus.ConvertToDouble();
+        }
+        EXPECT_NEAR(mean / size, 0.5, 0.01) << msg << " DUG mean for q = " << q;
+    }
+
+    // TUG: each of -1, 0, 1 with probability 1/3
+    TernaryUniformGeneratorImpl<V> tug;
+    auto ternary = tug.GenerateIntVector(size);
+    usint counts[3] = {0, 0, 0};
+    for (usint i = 0; i < size; i++) {
+        int32_t x = (ternary.get())[i];
+        ASSERT_TRUE(x >= -1 && x <= 1) << msg;
+        counts[x + 1]++;
+    }
+    for (auto c : counts)
+        EXPECT_NEAR(static_cast<double>(c) / size, 1.0 / 3, 0.01) << msg << " TUG frequencies";
+
+    // BUG: half ones
+    BinaryUniformGeneratorImpl<V> bug;
+    typename V::Integer modulus("10403");
+    V bits     = bug.GenerateVector(size, modulus);
+    usint ones = 0;
+    for (usint i = 0; i < size; i++) {
+        ASSERT_LE(bits[i], typename V::Integer(1)) << msg;
+        ones += bits[i] == typename V::Integer(1);
+    }
+    EXPECT_NEAR(static_cast<double>(ones) / size, 0.5, 0.01) << msg << " BUG frequency";
+}
+
+TEST(UTDistrGen, BulkGenerators) {
+    RUN_ALL_BACKENDS(BulkGenerators, "BulkGenerators")
+}
@@ -0,0 +1,247 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  This file tests the hash utilities
+ */
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include "include/gtest/gtest.h"
+
+#include "utils/hashutil.h"
+
+using namespace lbcrypto;
+
+namespace {
+template <size_t N>
+std::string ToHex(const std::array<uint8_t, N>& digest) {
+    std::stringstream s;
+    s.fill('0');
+    s << std::hex;
+    for (auto byte : digest)
+        s << std::setw(2) << static_cast<uint32_t>(byte);
+    return s.str();
+}
+}  // namespace
+
+TEST(UTHashUtil, SHA256Bytes_known_answers) {
+    std::string empty;
+    EXPECT_EQ(ToHex(HashUtil::SHA256Bytes(empty.data(), empty.size())),
+              "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+
+    std::string abc("abc");
+    EXPECT_EQ(ToHex(HashUtil::SHA256Bytes(abc.data(), abc.size())),
+              "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+
+    std::string twoBlocks("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq");
+    EXPECT_EQ(ToHex(HashUtil::SHA256Bytes(twoBlocks.data(), twoBlocks.size())),
+              "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST(UTHashUtil, HashString_known_answer) {
+    EXPECT_EQ(HashUtil::HashString("abc"), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+TEST(UTHashUtil, SHA256Hasher_streaming_matches_one_shot) {
+    // every chunk size around the block and padding boundaries, including bytes >= 0x80
+    std::string message;
+    for (size_t len = 0; len < 300; len++)
+        message.push_back(static_cast<char>(len * 37 + 11));
+
+    SHA256Digest expected = HashUtil::SHA256Bytes(message.data(), message.size());
+    SHA256Hasher hasher;
+    for (size_t chunk = 1; chunk < 130; chunk++) {
+        for (size_t pos = 0; pos < message.size(); pos += chunk)
+            hasher.Update(message.data() + pos, std::min(chunk, message.size() - pos));
+        EXPECT_EQ(hasher.Final(), expected) << "chunk size " << chunk;
+    }
+}
+
+TEST(UTHashUtil, Hash_SHA_256_is_standard) {
+    std::string abc("abc");
+    std::vector<int64_t> digest;
+    HashUtil::Hash(abc, SHA_256, digest);
+    SHA256Digest expected = HashUtil::SHA256Bytes(abc.data(), abc.size());
+    ASSERT_EQ(digest.size(), expected.size());
+    for (size_t i = 0; i < digest.size(); i++)
+        EXPECT_EQ(digest[i], expected[i]);
+}
+
+TEST(UTHashUtil, SHA256Multi_matches_SHA256Bytes) {
+    // lengths around the padding boundaries and counts that leave a partial group of 8
+    for (size_t length : {0, 1, 55, 56, 63, 64, 65, 119, 120, 200}) {
+        for (size_t count : {1, 7, 8, 9, 17}) {
+            std::vector<std::string> messages(count);
+            std::vector<const void*> pointers(count);
+            for (size_t i = 0; i < count; i++) {
+                for (size_t j = 0; j < length; j++)
+                    messages[i].push_back(static_cast<char>(i * 131 + j * 7 + 3));
+                pointers[i] = messages[i].data();
+            }
+            std::vector<SHA256Digest> digests(count);
+            HashUtil::SHA256Multi(pointers.data(), length, count, digests.data());
+            for (size_t i = 0; i < count; i++)
+                EXPECT_EQ(digests[i], HashUtil::SHA256Bytes(messages[i].data(), length))
+                    << "length " << length << ", count " << count << ", message " << i;
+        }
+    }
+}
+
+TEST(UTHashUtil, SHA256MultiAVX2_matches_SHA256Bytes) {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+    if (!__builtin_cpu_supports("avx2"))
+        GTEST_SKIP() << "the CPU does not support AVX2";
+#endif
+    // SHA256Multi does not use the 8-lane path on CPUs with the SHA extensions, so it is forced here
+    // and compared with the single-message digests; every byte value and multi-block messages
+    for (size_t length : {0, 1, 31, 55, 56, 63, 64, 65, 119, 120, 128, 200, 1000}) {
+        for (size_t count : {8, 16, 21}) {
+            std::vector<std::string> messages(count);
+            std::vector<const void*> pointers(count);
+            for (size_t i = 0; i < count; i++) {
+                for (size_t j = 0; j < length; j++)
+                    messages[i].push_back(static_cast<char>((i * 251 + j * 13 + length) & 0xFF));
+                pointers[i] = messages[i].data();
+            }
+            std::vector<SHA256Digest> digests(count);
+            HashUtil::SHA256MultiAVX2(pointers.data(), length, count, digests.data());
+            for (size_t i = 0; i < count; i++)
+                EXPECT_EQ(digests[i], HashUtil::SHA256Bytes(messages[i].data(), length))
+                    << "length " << length << ", count " << count << ", message " << i;
+        }
+    }
+}
+
+TEST(UTHashUtil, SHA512Bytes_known_answers) {
+    std::string empty;
+    EXPECT_EQ(ToHex(HashUtil::SHA512Bytes(empty.data(), empty.size())),
+              "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+              "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+
+    std::string abc("abc");
+    EXPECT_EQ(ToHex(HashUtil::SHA512Bytes(abc.data(), abc.size())),
+              "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+              "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+
+    std::string twoBlocks(
+        "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu");
+    EXPECT_EQ(ToHex(HashUtil::SHA512Bytes(twoBlocks.data(), twoBlocks.size())),
+              "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+              "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+}
+
+TEST(UTHashUtil, Hash_SHA_512_is_standard) {
+    std::string abc("abc");
+    std::vector<int64_t> digest;
+    HashUtil::Hash(abc, SHA_512, digest);
+    SHA512Digest expected = HashUtil::SHA512Bytes(abc.data(), abc.size());
+    ASSERT_EQ(digest.size(), expected.size());
+    for (size_t i = 0; i < digest.size(); i++)
+        EXPECT_EQ(digest[i], expected[i]);
+}
+
+TEST(UTHashUtil, SHA3_known_answers) {
+    std::string abc("abc");
+    std::array<uint8_t, 32> d256;
+    HashUtil::SHA3_256Bytes(abc.data(), abc.size(), d256.data());
+    EXPECT_EQ(ToHex(d256), "3a985da74fe225b2045c172d6bd390bd855f086e3e9d525b46bfe24511431532");
+
+    std::array<uint8_t, 64> d512;
+    HashUtil::SHA3_512Bytes(abc.data(), abc.size(), d512.data());
+    EXPECT_EQ(ToHex(d512),
+              "b751850b1a57168a5693cd924b6b096e08f621827444f70d884f5d0240d2712e"
+              "10e116e9192af3c91a7ec57647e3934057340b4cf408d5a56592f8274eec53f0");
+
+    std::string empty;
+    std::array<uint8_t, 32> s128;
+    HashUtil::SHAKE128(empty.data(), empty.size(), s128.data(), s128.size());
+    EXPECT_EQ(ToHex(s128), "7f9c2ba4e88f827d616045507605853ed73b8093f6efbc88eb1a6eacfa66ef26");
+
+    std::array<uint8_t, 64> s256;
+    HashUtil::SHAKE256(empty.data(), empty.size(), s256.data(), s256.size());
+    EXPECT_EQ(ToHex(s256),
+              "46b9dd2b0ba88d13233b3feb743eeb243fcd52ea62b81b82b50c27646ed5762f"
+              "d75dc4ddd8c0f200cb05019d67b592f6fc821c49479ab48640292eacb3b7c4be");
+}
+
+TEST(UTHashUtil, KeccakHasher_streaming_matches_one_shot) {
+    // message lengths across the SHAKE128 rate (168 bytes), absorbed and squeezed in odd chunks
+    std::string message;
+    for (size_t len = 0; len < 400; len++)
+        message.push_back(static_cast<char>(len * 37 + 11));
+
+    std::vector<uint8_t> expected(500);
+    HashUtil::SHAKE128(message.data(), message.size(), expected.data(), expected.size());
+    for (size_t chunk : {1, 7, 8, 9, 167, 168, 169}) {
+        KeccakHasher hasher(SHAKE_128);
+        for (size_t pos = 0; pos < message.size(); pos += chunk)
+            hasher.Update(message.data() + pos, std::min(chunk, message.size() - pos));
+        std::vector<uint8_t> out(expected.size());
+        for (size_t pos = 0; pos < out.size(); pos += chunk)
+            hasher.Squeeze(out.data() + pos, std::min(chunk, out.size() - pos));
+        EXPECT_EQ(out, expected) << "chunk size " << chunk;
+    }
+}
+
+TEST(UTHashUtil, KeccakHasherX4_matches_single) {
+    for (HashAlgorithm algo : {SHAKE_128, SHAKE_256}) {
+        for (size_t length : {0, 34, 135, 136, 167, 168, 300}) {
+            std::vector<std::vector<uint8_t>> messages(4, std::vector<uint8_t>(length));
+            const void* in[4];
+            for (size_t j = 0; j < 4; j++) {
+                for (size_t i = 0; i < length; i++)
+                    messages[j][i] = static_cast<uint8_t>(j * 101 + i * 13);
+                in[j] = messages[j].data();
+            }
+
+            KeccakHasherX4 hasherX4(algo);
+            const size_t nblocks = 3;
+            std::vector<std::vector<uint8_t>> outputs(4, std::vector<uint8_t>(nblocks * hasherX4.Rate()));
+            uint8_t* out[4] = {outputs[0].data(), outputs[1].data(), outputs[2].data(), outputs[3].data()};
+            hasherX4.Absorb(in, length);
+            hasherX4.SqueezeBlocks(out, 1);
+            for (size_t j = 0; j < 4; j++)
+                out[j] += hasherX4.Rate();
+            hasherX4.SqueezeBlocks(out, nblocks - 1);
+
+            for (size_t j = 0; j < 4; j++) {
+                std::vector<uint8_t> expected(outputs[j].size());
+                KeccakHasher hasher(algo);
+                hasher.Update(messages[j].data(), length);
+                hasher.Squeeze(expected.data(), expected.size());
+                EXPECT_EQ(outputs[j], expected) << "length " << length << ", instance " << j;
+            }
+        }
+    }
+}
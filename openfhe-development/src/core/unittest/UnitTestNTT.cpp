@@ -39,9 +39,14 @@
   */
 
 #include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
 #include "gtest/gtest.h"
 
 #include "lattice/lat-hal.h"
+#include "lattice/hal/default/poly16.h"
+#include "math/hal/intnat/transformincomplete.h"
 #include "math/distrgen.h"
 #include "math/nbtheory.h"
 #include "testdefs.h"
@@ -119,3 +124,144 @@ void switch_format_simple_double_crt(const std::string& msg) {
 TEST(UTNTT, switch_format_simple_double_crt) {
     RUN_BIG_DCRTPOLYS(switch_format_simple_double_crt, "switch_format_simple_double_crt")
 }
+
+// negacyclic schoolbook product mod q, the reference for IncompleteNTT16
+static std::vector<int64_t> NegacyclicProduct(const std::vector<int16_t>& a, const std::vector<int16_t>& b, int64_t q) {
+    size_t n = a.size();
+    std::vector<int64_t> c(n, 0);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            int64_t prod = static_cast<int64_t>(a[i]) * b[j];
+            if (i + j < n)
+                c[i + j] += prod;
+            else
+                c[i + j - n] -= prod;
+        }
+    }
+    for (auto& x : c)
+        x = ((x % q) + q) % q;
+    return c;
+}
+
+TEST(UTNTT, incomplete_ntt16) {
+    std::mt19937 gen(42);
+    for (auto params : std::vector<std::pair<uint32_t, uint16_t>>{{256, 3329}, {64, 3329}, {16, 3329}, {128, 2689}}) {
+        uint32_t n = params.first;
+        uint16_t q = params.second;
+        intnat::IncompleteNTT16 ntt(n, q);
+        intnat::IncompleteNTT16 scalar(n, q, false);
+        std::uniform_int_distribution<int> dist(-q, q);
+
+        std::vector<int16_t> a(n), b(n);
+        for (uint32_t i = 0; i < n; i++) {
+            a[i] = static_cast<int16_t>(dist(gen));
+            b[i] = static_cast<int16_t>(dist(gen));
+        }
+
+        // forward/inverse round trip, identical with and without AVX2
+        std::vector<int16_t> x(a), y(a);
+        ntt.ForwardTransform(x.data());
+        scalar.ForwardTransform(y.data());
+        EXPECT_EQ(x, y) << "forward transform, n = " << n << ", q = " << q;
+        ntt.InverseTransform(x.data());
+        scalar.InverseTransform(y.data());
+        EXPECT_EQ(x, y) << "inverse transform, n = " << n << ", q = " << q;
+        ntt.Reduce(x.data());
+        for (uint32_t i = 0; i < n; i++)
+            EXPECT_EQ(x[i], ((a[i] % q) + q) % q) << "round trip, n = " << n << ", q = " << q << ", i = " << i;
+
+        // base-case multiplication in the NTT domain is the negacyclic product
+        std::vector<int16_t> fa(a), fb(b), c(n), d(n);
+        ntt.ForwardTransform(fa.data());
+        ntt.ForwardTransform(fb.data());
+        ntt.BaseCaseMultiply(fa.data(), fb.data(), c.data());
+        scalar.BaseCaseMultiply(fa.data(), fb.data(), d.data());
+        EXPECT_EQ(c, d) << "base-case multiplication, n = " << n << ", q = " << q;
+
+        // the fused multiply-add equals the product times 2^16 added to the accumulator, with and without AVX2
+        std::vector<int16_t> acc(b), prod(c);
+        ntt.Reduce(acc.data());
+        std::vector<int16_t> accScalar(acc), accExpected(acc);
+        ntt.BaseCaseMultiplyAdd(fa.data(), fb.data(), acc.data());
+        scalar.BaseCaseMultiplyAdd(fa.data(), fb.data(), accScalar.data());
+        ntt.ToMontgomery(prod.data());
+        for (uint32_t i = 0; i < n; i++)
+            accExpected[i] = static_cast<int16_t>(accExpected[i] + prod[i]);
+        ntt.Reduce(accExpected.data());
+        EXPECT_EQ(acc, accExpected) << "base-case multiply-add, n = " << n << ", q = " << q;
+        EXPECT_EQ(accScalar, accExpected) << "scalar base-case multiply-add, n = " << n << ", q = " << q;
+        ntt.ToMontgomery(c.data());
+        ntt.InverseTransform(c.data());
+        ntt.Reduce(c.data());
+        std::vector<int64_t> expected = NegacyclicProduct(a, b, q);
+        for (uint32_t i = 0; i < n; i++)
+            EXPECT_EQ(c[i], expected[i]) << "product, n = " << n << ", q = " << q << ", i = " << i;
+    }
+
+    EXPECT_THROW(intnat::IncompleteNTT16(256, 7681), OpenFHEException);
+    EXPECT_THROW(intnat::IncompleteNTT16(512, 3329), OpenFHEException);
+}
+
+TEST(UTNTT, poly16) {
+    const uint32_t n = 256;
+    const uint16_t q = 3329;
+    auto ntt         = std::make_shared<const intnat::IncompleteNTT16>(n, q);
+    std::mt19937 gen(7);
+    std::uniform_int_distribution<int> dist(-3 * q, 3 * q);
+
+    std::vector<int16_t> a(n), b(n), c(n);
+    intnat::NativeVector16 va(n, q), vb(n, q), vc(n, q);
+    for (uint32_t i = 0; i < n; i++) {
+        a[i]  = static_cast<int16_t>(dist(gen));
+        b[i]  = static_cast<int16_t>(dist(gen));
+        c[i]  = static_cast<int16_t>(dist(gen));
+        va[i] = a[i];
+        vb[i] = b[i];
+        vc[i] = c[i];
+    }
+
+    // vector arithmetic in [0, q)
+    va.Reduce();
+    vb.Reduce();
+    vc.Reduce();
+    intnat::NativeVector16 sum = va.ModAdd(vb), diff = va.ModSub(vb), prod = va.ModMul(vb);
+    for (uint32_t i = 0; i < n; i++) {
+        int64_t x = ((a[i] % q) + q) % q, y = ((b[i] % q) + q) % q;
+        EXPECT_EQ(va[i], x) << "reduce, i = " << i;
+        EXPECT_EQ(sum[i], (x + y) % q) << "add, i = " << i;
+        EXPECT_EQ(diff[i], (x - y + q) % q) << "sub, i = " << i;
+        EXPECT_EQ(prod[i], x * y % q) << "mul, i = " << i;
+    }
+    EXPECT_EQ(intnat::NativeVector16(4, q, {-1, q, 5}), intnat::NativeVector16(4, q, {q - 1, 0, 5, 0}));
+    intnat::NativeVector16 w(4, q, {q - 1, 1, 5});
+    w.ModAddAtIndex(0, (q + 1) / 2).ModAddAtIndex(1, -2).ModAddAtIndex(2, 3 * q);
+    EXPECT_EQ(w, intnat::NativeVector16(4, q, {(q - 1) / 2, q - 1, 5, 0}));
+    EXPECT_THROW(w.ModAddAtIndex(4, 1), OpenFHEException);
+    EXPECT_THROW(intnat::Modulus16(7681), OpenFHEException);
+
+    // ring arithmetic through the incomplete NTT: a * b + c
+    Poly16 pa(ntt, Format::COEFFICIENT), pb(ntt, Format::COEFFICIENT), pc(ntt, Format::COEFFICIENT);
+    pa.SetValues(va, Format::COEFFICIENT);
+    pb.SetValues(vb, Format::COEFFICIENT);
+    pc.SetValues(vc, Format::COEFFICIENT);
+    Poly16 coeffSum = pa + pc;
+    pa.SwitchFormat();
+    pb.SwitchFormat();
+    pc.SwitchFormat();
+    Poly16 r = pa * pb + pc, s(pc);
+    s.AddProductEq(pa, pb);
+    EXPECT_EQ(r, s);
+    Poly16 t(pa);
+    t.AddProductEq(t, pb);
+    EXPECT_EQ(t, pa * pb + pa) << "AddProductEq with an aliased operand";
+    r.SetFormat(Format::COEFFICIENT);
+
+    std::vector<int64_t> expected = NegacyclicProduct(a, b, q);
+    for (uint32_t i = 0; i < n; i++) {
+        EXPECT_EQ(r[i], (expected[i] + vc[i]) % q) << "a * b + c, i = " << i;
+        EXPECT_EQ(coeffSum[i], (va[i] + vc[i]) % q) << "a + c, i = " << i;
+    }
+    pc.SetFormat(Format::COEFFICIENT);
+    EXPECT_EQ(pc.GetValues(), vc);
+    EXPECT_THROW(pa * coeffSum, OpenFHEException);
+}
@@ -0,0 +1,2274 @@
+// Implementazione del KEM (LWE e Module-LWE), senza main(): LWE-KEM.cpp e il benchmark
+// openfhe-development/benchmark/src/lwe-kem.cpp la includono. Le funzioni sono inline, i kernel scelti
+// via CPUID sono variabili inline (C++17) e i nomi di OpenFHE sono qualificati con lbcrypto::, quindi
+// si puo' includere in piu' unita' di traduzione con una sola copia di ogni funzione e dispatch.
+#ifndef LWE_KEM_H
+#define LWE_KEM_H
+
+#include "openfhe.h"
+#include "openfhecore.h"
+
+#include "lwe-pke.h"
+#include "binfhecontext.h"
+
+#include "utils/hashutil.h"
+#include "utils/memory.h"
+
+#include "math/discretegaussiangenerator.h"
+#include "math/distributiongenerator.h"
+#include "utils/prng/blake2engine.h"
+#include "math/hal/integer.h"
+#include "lattice/hal/default/poly16.h"
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+
+#include <random>
+#include <sstream>
+#include <iomanip>
+
+#include <chrono>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include <omp.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+// GCC segnala come non inizializzati i valori _mm512_undefined_* dei suoi header AVX-512
+// (falso positivo): l'avviso viene soppresso solo per queste righe
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#else
+#include <immintrin.h>
+#endif
+#define LWE_KEM_X86
+#endif
+
+inline int mod(int a, int b)
+{
+    return (a % b + b) % b;
+}
+
+// Riduzione di Barrett per q < 2^16: un solo prodotto a 128 bit al posto dei due %
+// di mod(). I kernel sotto accumulano in lane a 64 bit e riducono una volta per riga.
+struct BarrettModulus
+{
+    explicit BarrettModulus(uint32_t modulus)
+        : q(modulus), mu(static_cast<uint64_t>((static_cast<unsigned __int128>(1) << 64) / modulus)),
+          offset((static_cast<uint64_t>(1) << 62) / modulus * modulus)
+    {
+    }
+
+    // x mod q in [0, q) per |x| < 2^61
+    int32_t Reduce(int64_t x) const
+    {
+        uint64_t y = static_cast<uint64_t>(x) + offset;
+        uint64_t quot = static_cast<uint64_t>((static_cast<unsigned __int128>(y) * mu) >> 64);
+        uint64_t r = y - quot * q;
+        return static_cast<int32_t>(r >= q ? r - q : r);
+    }
+
+    uint64_t q;
+    uint64_t mu;
+    uint64_t offset;
+};
+
+// Kernel di prodotto scalare (somma esatta a 64 bit di a_i * b_i) e di axpy (acc += x * a).
+// La variante AVX2/AVX-512 e' scelta a runtime tramite CPUID, con fallback scalare.
+using DotKernel = int64_t (*)(const int32_t *, const int32_t *, size_t);
+using AxpyKernel = void (*)(int64_t *, const int32_t *, int32_t, size_t);
+
+inline int64_t DotScalar(const int32_t *a, const int32_t *b, size_t len)
+{
+    int64_t acc = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+        acc += static_cast<int64_t>(a[i]) * b[i];
+    }
+    return acc;
+}
+
+inline void AxpyScalar(int64_t *acc, const int32_t *x, int32_t a, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+    {
+        acc[i] += static_cast<int64_t>(x[i]) * a;
+    }
+}
+
+#ifdef LWE_KEM_X86
+// _mm256_mul_epi32 moltiplica i 32 bit bassi (con segno) di ogni lane a 64 bit:
+// un prodotto sugli elementi pari e uno, dopo lo shift, su quelli dispari
+__attribute__((target("avx2"))) inline int64_t DotAVX2(const int32_t *a, const int32_t *b, size_t len)
+{
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        acc0 = _mm256_add_epi64(acc0, _mm256_mul_epi32(va, vb));
+        acc1 = _mm256_add_epi64(acc1, _mm256_mul_epi32(_mm256_srli_epi64(va, 32), _mm256_srli_epi64(vb, 32)));
+    }
+    acc0 = _mm256_add_epi64(acc0, acc1);
+    __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc0), _mm256_extracti128_si256(acc0, 1));
+    int64_t acc = _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+    return acc + DotScalar(a + i, b + i, len - i);
+}
+
+__attribute__((target("avx2"))) inline void AxpyAVX2(int64_t *acc, const int32_t *x, int32_t a, size_t len)
+{
+    const __m256i va = _mm256_set1_epi64x(a);
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4)
+    {
+        __m256i vx = _mm256_cvtepi32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x + i)));
+        __m256i *dst = reinterpret_cast<__m256i *>(acc + i);
+        _mm256_storeu_si256(dst, _mm256_add_epi64(_mm256_loadu_si256(dst), _mm256_mul_epi32(vx, va)));
+    }
+    AxpyScalar(acc + i, x + i, a, len - i);
+}
+
+__attribute__((target("avx512f"))) inline int64_t DotAVX512(const int32_t *a, const int32_t *b, size_t len)
+{
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m512i va = _mm512_loadu_si512(a + i);
+        __m512i vb = _mm512_loadu_si512(b + i);
+        acc0 = _mm512_add_epi64(acc0, _mm512_mul_epi32(va, vb));
+        acc1 = _mm512_add_epi64(acc1, _mm512_mul_epi32(_mm512_srli_epi64(va, 32), _mm512_srli_epi64(vb, 32)));
+    }
+    int64_t acc = _mm512_reduce_add_epi64(_mm512_add_epi64(acc0, acc1));
+    return acc + DotScalar(a + i, b + i, len - i);
+}
+
+__attribute__((target("avx512f"))) inline void AxpyAVX512(int64_t *acc, const int32_t *x, int32_t a, size_t len)
+{
+    const __m512i va = _mm512_set1_epi64(a);
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        __m512i vx = _mm512_cvtepi32_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i)));
+        _mm512_storeu_si512(acc + i, _mm512_add_epi64(_mm512_loadu_si512(acc + i), _mm512_mul_epi32(vx, va)));
+    }
+    AxpyScalar(acc + i, x + i, a, len - i);
+}
+#endif
+
+inline DotKernel SelectDotKernel()
+{
+#ifdef LWE_KEM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return DotAVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return DotAVX2;
+    }
+#endif
+    return DotScalar;
+}
+
+inline AxpyKernel SelectAxpyKernel()
+{
+#ifdef LWE_KEM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return AxpyAVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return AxpyAVX2;
+    }
+#endif
+    return AxpyScalar;
+}
+
+// Variante a 4 colonne per il prodotto a blocchi A^T * R: ogni blocco di a viene
+// caricato una volta e usato per 4 vettori b
+using Dot4Kernel = void (*)(const int32_t *, const int32_t *const *, size_t, int64_t *);
+
+inline void Dot4Scalar(const int32_t *a, const int32_t *const *b, size_t len, int64_t *out)
+{
+    for (size_t l = 0; l < 4; ++l)
+    {
+        out[l] = DotScalar(a, b[l], len);
+    }
+}
+
+#ifdef LWE_KEM_X86
+__attribute__((target("avx2"))) inline void Dot4AVX2(const int32_t *a, const int32_t *const *b, size_t len, int64_t *out)
+{
+    __m256i acc[4];
+    for (size_t l = 0; l < 4; ++l)
+    {
+        acc[l] = _mm256_setzero_si256();
+    }
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8)
+    {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i vaOdd = _mm256_srli_epi64(va, 32);
+        for (size_t l = 0; l < 4; ++l)
+        {
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b[l] + i));
+            acc[l] = _mm256_add_epi64(acc[l], _mm256_mul_epi32(va, vb));
+            acc[l] = _mm256_add_epi64(acc[l], _mm256_mul_epi32(vaOdd, _mm256_srli_epi64(vb, 32)));
+        }
+    }
+    for (size_t l = 0; l < 4; ++l)
+    {
+        __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc[l]), _mm256_extracti128_si256(acc[l], 1));
+        out[l] = _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1) + DotScalar(a + i, b[l] + i, len - i);
+    }
+}
+
+__attribute__((target("avx512f"))) inline void Dot4AVX512(const int32_t *a, const int32_t *const *b, size_t len, int64_t *out)
+{
+    __m512i acc[4];
+    for (size_t l = 0; l < 4; ++l)
+    {
+        acc[l] = _mm512_setzero_si512();
+    }
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16)
+    {
+        __m512i va = _mm512_loadu_si512(a + i);
+        __m512i vaOdd = _mm512_srli_epi64(va, 32);
+        for (size_t l = 0; l < 4; ++l)
+        {
+            __m512i vb = _mm512_loadu_si512(b[l] + i);
+            acc[l] = _mm512_add_epi64(acc[l], _mm512_mul_epi32(va, vb));
+            acc[l] = _mm512_add_epi64(acc[l], _mm512_mul_epi32(vaOdd, _mm512_srli_epi64(vb, 32)));
+        }
+    }
+    for (size_t l = 0; l < 4; ++l)
+    {
+        out[l] = _mm512_reduce_add_epi64(acc[l]) + DotScalar(a + i, b[l] + i, len - i);
+    }
+}
+#endif
+
+inline Dot4Kernel SelectDot4Kernel()
+{
+#ifdef LWE_KEM_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return Dot4AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return Dot4AVX2;
+    }
+#endif
+    return Dot4Scalar;
+}
+
+inline const DotKernel DotInt32 = SelectDotKernel();
+inline const Dot4Kernel Dot4Int32 = SelectDot4Kernel();
+inline const AxpyKernel AxpyInt64 = SelectAxpyKernel();
+
+// <a, b> mod q con una sola riduzione finale
+inline int32_t InnerProductModQ(const int32_t *a, const int32_t *b, size_t len, const BarrettModulus &q)
+{
+    return q.Reduce(DotInt32(a, b, len));
+}
+
+// Matrice rows x cols in un unico buffer row-major allineato a 64 byte (AlignedAllocator di OpenFHE).
+// Ogni riga e' paddata a un multiplo di 16 interi, quindi inizia sempre su una
+// nuova cache line. La trasposta viene calcolata una sola volta (UpdateTranspose)
+// e riusata da tutte le Encrypt, invece di ricostruirla a ogni incapsulamento.
+class MatrixInt32
+{
+public:
+    static constexpr size_t kRowAlign = 64 / sizeof(int32_t);
+
+    MatrixInt32() = default;
+
+    MatrixInt32(size_t rows, size_t cols)
+        : rows_(rows), cols_(cols), stride_(RoundUp(cols)), data_(rows * RoundUp(cols), 0)
+    {
+    }
+
+    size_t Rows() const { return rows_; }
+    size_t Cols() const { return cols_; }
+    size_t Stride() const { return stride_; }
+
+    int32_t *Row(size_t i) { return data_.data() + i * stride_; }
+    const int32_t *Row(size_t i) const { return data_.data() + i * stride_; }
+
+    int32_t &operator()(size_t i, size_t j) { return data_[i * stride_ + j]; }
+    int32_t operator()(size_t i, size_t j) const { return data_[i * stride_ + j]; }
+
+    // Riga j di A^T, cioe' la colonna j di A (contigua)
+    const int32_t *TransposedRow(size_t j) const
+    {
+        if (transp_.empty())
+        {
+            throw std::logic_error("MatrixInt32: trasposta non calcolata, chiamare UpdateTranspose()");
+        }
+        return transp_.data() + j * transpStride_;
+    }
+
+    bool HasTranspose() const { return !transp_.empty(); }
+
+    // Trasposta a blocchi 16x16, cosi' sia la lettura che la scrittura restano in cache
+    void UpdateTranspose()
+    {
+        transpStride_ = RoundUp(rows_);
+        transp_.assign(cols_ * transpStride_, 0);
+        constexpr size_t B = kRowAlign;
+        for (size_t ii = 0; ii < rows_; ii += B)
+        {
+            size_t iEnd = std::min(ii + B, rows_);
+            for (size_t jj = 0; jj < cols_; jj += B)
+            {
+                size_t jEnd = std::min(jj + B, cols_);
+                for (size_t i = ii; i < iEnd; ++i)
+                {
+                    const int32_t *src = Row(i);
+                    for (size_t j = jj; j < jEnd; ++j)
+                    {
+                        transp_[j * transpStride_ + i] = src[j];
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    static size_t RoundUp(size_t x)
+    {
+        return (x + kRowAlign - 1) / kRowAlign * kRowAlign;
+    }
+
+    size_t rows_ = 0;
+    size_t cols_ = 0;
+    size_t stride_ = 0;
+    size_t transpStride_ = 0;
+    std::vector<int32_t, lbcrypto::AlignedAllocator<int32_t>> data_;
+    std::vector<int32_t, lbcrypto::AlignedAllocator<int32_t>> transp_;
+};
+
+inline MatrixInt32 GenerateRandomMatrixInt32(size_t rows, size_t cols, int32_t maxValue)
+{
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::uniform_int_distribution<int32_t> dist(0, maxValue);
+
+    MatrixInt32 matrix(rows, cols);
+
+    for (size_t i = 0; i < rows; ++i)
+    {
+        int32_t *row = matrix.Row(i);
+        for (size_t j = 0; j < cols; ++j)
+        {
+            row[j] = dist(rng);
+        }
+    }
+
+    return matrix;
+}
+
+// Modalita' "seed": la chiave pubblica contiene solo rho (32 byte) e t, mentre A
+// viene rigenerata riga per riga da SHAKE128(rho || i) (ExpandMatrixRow), come in Kyber.
+// I semi da 32 byte sono tipi distinti: rho (MatrixSeed) genera A ed e' pubblico, mentre i semi
+// delle PRF (PrfSeed: rumore CBD, coins, chiave di rifiuto z) restano segreti
+struct MatrixSeed : std::array<uint8_t, 32>
+{
+};
+
+struct PrfSeed : std::array<uint8_t, 32>
+{
+};
+
+struct SeededMatrix
+{
+    MatrixSeed rho{};
+    uint32_t rows = 0;
+    uint32_t cols = 0;
+    uint32_t q = 0;
+};
+
+// blocchi SHAKE128 (168 byte, 112 candidati a 12 bit) spremuti per volta durante l'espansione
+constexpr size_t kExpandBlocks = 4;
+constexpr size_t kShake128Rate = 168;
+
+// Seme casuale di tipo Seed (MatrixSeed, PrfSeed o un altro std::array di byte) da std::random_device
+template <typename Seed>
+Seed GenerateSeed()
+{
+    static_assert(sizeof(Seed) % 4 == 0, "il seme e' riempito a parole da 32 bit");
+    std::random_device rd;
+    Seed seed;
+    for (size_t i = 0; i < seed.size(); i += 4)
+    {
+        uint32_t word = rd();
+        std::memcpy(seed.data() + i, &word, 4);
+    }
+    return seed;
+}
+
+// Rejection sampling mod q di valori a 12 bit presi da buf; riprende da filled
+template <typename Coeff>
+void ParseUniform12(const uint8_t *buf, size_t len, uint32_t q, Coeff *row, size_t &filled, size_t cols)
+{
+    for (size_t k = 0; k + 3 <= len && filled < cols; k += 3)
+    {
+        uint32_t d1 = buf[k] | (static_cast<uint32_t>(buf[k + 1] & 0x0F) << 8);
+        uint32_t d2 = (buf[k + 1] >> 4) | (static_cast<uint32_t>(buf[k + 2]) << 4);
+        if (d1 < q)
+        {
+            row[filled++] = static_cast<Coeff>(d1);
+        }
+        if (d2 < q && filled < cols)
+        {
+            row[filled++] = static_cast<Coeff>(d2);
+        }
+    }
+}
+
+// input dello XOF per la riga i: rho || i (4 byte little endian)
+inline std::array<uint8_t, 36> ExpandInput(const MatrixSeed &rho, uint32_t i)
+{
+    std::array<uint8_t, 36> in;
+    std::copy(rho.begin(), rho.end(), in.begin());
+    for (size_t k = 0; k < 4; ++k)
+    {
+        in[rho.size() + k] = static_cast<uint8_t>(i >> (8 * k));
+    }
+    return in;
+}
+
+// Riga i di A = rejection sampling mod q sull'output di SHAKE128(rho || i).
+// Il numero di blocchi non e' noto a priori, quindi lo XOF viene spremuto finche' serve.
+inline void ExpandMatrixRow(const SeededMatrix &A, uint32_t i, int32_t *row)
+{
+    uint8_t buf[kExpandBlocks * kShake128Rate];
+    std::array<uint8_t, 36> in = ExpandInput(A.rho, i);
+    lbcrypto::KeccakHasher xof(lbcrypto::SHAKE_128);
+    xof.Update(in.data(), in.size());
+
+    size_t filled = 0;
+    while (filled < A.cols)
+    {
+        xof.Squeeze(buf, sizeof(buf));
+        ParseUniform12(buf, sizeof(buf), A.q, row, filled, A.cols);
+    }
+}
+
+// Righe i, ..., i + 3 di A con quattro SHAKE128 in parallelo: stesso risultato di
+// quattro ExpandMatrixRow, al costo di circa una sola permutazione per blocco
+inline void ExpandMatrixRows4(const SeededMatrix &A, uint32_t i, int32_t *const rows[4])
+{
+    uint8_t buf[4][kExpandBlocks * kShake128Rate];
+    uint8_t *out[4] = {buf[0], buf[1], buf[2], buf[3]};
+    std::array<uint8_t, 36> in[4];
+    const void *msgs[4];
+    for (uint32_t l = 0; l < 4; ++l)
+    {
+        in[l] = ExpandInput(A.rho, i + l);
+        msgs[l] = in[l].data();
+    }
+    lbcrypto::KeccakHasherX4 xof(lbcrypto::SHAKE_128);
+    xof.Absorb(msgs, in[0].size());
+
+    size_t filled[4] = {0, 0, 0, 0};
+    while (filled[0] < A.cols || filled[1] < A.cols || filled[2] < A.cols || filled[3] < A.cols)
+    {
+        xof.SqueezeBlocks(out, kExpandBlocks);
+        for (size_t l = 0; l < 4; ++l)
+        {
+            ParseUniform12(buf[l], sizeof(buf[l]), A.q, rows[l], filled[l], A.cols);
+        }
+    }
+}
+
+// Chiama f(j, A_j) per ogni riga di A, espandendo le righe a gruppi di 4 nel buffer
+// buf (4 * A.cols interi) che resta in cache; la riga vale solo durante la chiamata
+template <typename RowFn>
+void ForEachMatrixRow(const SeededMatrix &A, int32_t *buf, RowFn &&f)
+{
+    int32_t *rows[4] = {buf, buf + A.cols, buf + 2 * A.cols, buf + 3 * A.cols};
+    uint32_t j = 0;
+    for (; j + 4 <= A.rows; j += 4)
+    {
+        ExpandMatrixRows4(A, j, rows);
+        for (uint32_t l = 0; l < 4; ++l)
+        {
+            f(j + l, rows[l]);
+        }
+    }
+    for (; j < A.rows; ++j)
+    {
+        ExpandMatrixRow(A, j, rows[0]);
+        f(j, rows[0]);
+    }
+}
+
+template <typename RowFn>
+void ForEachMatrixRow(const SeededMatrix &A, RowFn &&f)
+{
+    std::vector<int32_t, lbcrypto::AlignedAllocator<int32_t>> buf(4 * static_cast<size_t>(A.cols));
+    ForEachMatrixRow(A, buf.data(), std::forward<RowFn>(f));
+}
+
+inline SeededMatrix GenerateSeededMatrix(uint32_t rows, uint32_t cols, uint32_t q)
+{
+    if (q > 4096)
+    {
+        throw std::invalid_argument("GenerateSeededMatrix: q deve stare in 12 bit");
+    }
+    SeededMatrix A;
+    A.rho = GenerateSeed<MatrixSeed>();
+    A.rows = rows;
+    A.cols = cols;
+    A.q = q;
+    return A;
+}
+
+// Espansione completa, utile solo per confronti con la modalita' a matrice memorizzata
+inline MatrixInt32 ExpandMatrix(const SeededMatrix &A)
+{
+    MatrixInt32 matrix(A.rows, A.cols);
+    ForEachMatrixRow(A, [&](uint32_t i, const int32_t *A_i)
+                     { std::copy(A_i, A_i + A.cols, matrix.Row(i)); });
+    matrix.UpdateTranspose();
+    return matrix;
+}
+
+inline std::vector<uint32_t> GenerateRandomBitVectorUInt32(size_t n)
+{
+    std::random_device rd;
+    std::mt19937 rng(rd());
+    std::uniform_int_distribution<uint32_t> dist(0, 1);
+
+    std::vector<uint32_t> vec;
+    vec.reserve(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        vec.push_back(dist(rng));
+    }
+
+    return vec;
+}
+
+// Campionatore CDT costruito una volta per stddev e condiviso fra i thread: la tabella
+// e' di sola lettura e ogni thread usa il proprio PRNG
+inline const lbcrypto::DiscreteGaussianGeneratorImpl<lbcrypto::NativeVector> &GaussianSampler(double stddev)
+{
+    static std::mutex mutex;
+    static std::map<double, std::unique_ptr<lbcrypto::DiscreteGaussianGeneratorImpl<lbcrypto::NativeVector>>> samplers;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &dgg = samplers[stddev];
+    if (!dgg)
+    {
+        dgg = std::make_unique<lbcrypto::DiscreteGaussianGeneratorImpl<lbcrypto::NativeVector>>(stddev, lbcrypto::CDT_CONSTANT_TIME);
+    }
+    return *dgg;
+}
+
+inline std::vector<int32_t> GenerateGaussianVector(size_t m, lbcrypto::NativeInteger q, double stddev)
+{
+    std::vector<int32_t> vec(m);
+    GaussianSampler(stddev).GenerateIntVector(vec.data(), m);
+    return vec;
+}
+
+// Distribuzione binomiale centrata CBD_eta su un flusso di byte pseudocasuali: il
+// coefficiente i usa i 2*eta bit i*2*eta, ..., (i+1)*2*eta - 1 (dal bit meno significativo
+// di ogni byte) e vale (somma dei primi eta) - (somma degli altri eta).
+// Le varianti per eta = 1, 2, 3 contano i bit a gruppi dentro una parola (bit-slicing),
+// quella AVX2 lavora su 32 byte alla volta; tutte producono gli stessi coefficienti.
+inline void CbdGeneric(const uint8_t *buf, uint8_t eta, int32_t *coeffs, size_t n)
+{
+    size_t bit = 0;
+    for (size_t i = 0; i < n; ++i)
+    {
+        int32_t a = 0, b = 0;
+        for (uint8_t k = 0; k < eta; ++k, ++bit)
+        {
+            a += (buf[bit / 8] >> (bit % 8)) & 1;
+        }
+        for (uint8_t k = 0; k < eta; ++k, ++bit)
+        {
+            b += (buf[bit / 8] >> (bit % 8)) & 1;
+        }
+        coeffs[i] = a - b;
+    }
+}
+
+inline uint64_t LoadLE(const uint8_t *buf, size_t bytes)
+{
+    uint64_t w = 0;
+    for (size_t k = 0; k < bytes; ++k)
+    {
+        w |= static_cast<uint64_t>(buf[k]) << (8 * k);
+    }
+    return w;
+}
+
+// eta = 1: 32 coefficienti per parola da 64 bit
+inline void Cbd1Swar(const uint8_t *buf, int32_t *coeffs, size_t n)
+{
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32, buf += 8)
+    {
+        uint64_t w = LoadLE(buf, 8);
+        for (size_t j = 0; j < 32; ++j)
+        {
+            coeffs[i + j] = static_cast<int32_t>((w >> (2 * j)) & 1) - static_cast<int32_t>((w >> (2 * j + 1)) & 1);
+        }
+    }
+    CbdGeneric(buf, 1, coeffs + i, n - i);
+}
+
+// eta = 2: ogni campo da 2 bit di t contiene la somma di due bit, 16 coefficienti per parola
+inline void Cbd2Swar(const uint8_t *buf, int32_t *coeffs, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16, buf += 8)
+    {
+        uint64_t w = LoadLE(buf, 8);
+        uint64_t t = (w & 0x5555555555555555ULL) + ((w >> 1) & 0x5555555555555555ULL);
+        for (size_t j = 0; j < 16; ++j)
+        {
+            coeffs[i + j] = static_cast<int32_t>((t >> (4 * j)) & 3) - static_cast<int32_t>((t >> (4 * j + 2)) & 3);
+        }
+    }
+    CbdGeneric(buf, 2, coeffs + i, n - i);
+}
+
+// eta = 3: somme di tre bit in campi da 3 bit, 8 coefficienti ogni 48 bit
+inline void Cbd3Swar(const uint8_t *buf, int32_t *coeffs, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8, buf += 6)
+    {
+        uint64_t w = LoadLE(buf, 6);
+        uint64_t t = (w & 0x249249249249ULL) + ((w >> 1) & 0x249249249249ULL) + ((w >> 2) & 0x249249249249ULL);
+        for (size_t j = 0; j < 8; ++j)
+        {
+            coeffs[i + j] = static_cast<int32_t>((t >> (6 * j)) & 7) - static_cast<int32_t>((t >> (6 * j + 3)) & 7);
+        }
+    }
+    CbdGeneric(buf, 3, coeffs + i, n - i);
+}
+
+#ifdef LWE_KEM_X86
+// estende 32 coefficienti a 8 bit in ordine in coeffs
+__attribute__((target("avx2"))) inline void StoreInt8x32(__m128i lo, __m128i hi, int32_t *coeffs)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(coeffs), _mm256_cvtepi8_epi32(lo));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(coeffs + 8), _mm256_cvtepi8_epi32(_mm_srli_si128(lo, 8)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(coeffs + 16), _mm256_cvtepi8_epi32(hi));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(coeffs + 24), _mm256_cvtepi8_epi32(_mm_srli_si128(hi, 8)));
+}
+
+// eta = 2: 32 byte -> 64 coefficienti, due per byte
+__attribute__((target("avx2"))) inline void Cbd2AVX2(const uint8_t *buf, int32_t *coeffs, size_t n)
+{
+    const __m256i m55 = _mm256_set1_epi8(0x55);
+    const __m256i m03 = _mm256_set1_epi8(0x03);
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64, buf += 32)
+    {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(buf));
+        __m256i t = _mm256_add_epi8(_mm256_and_si256(x, m55), _mm256_and_si256(_mm256_srli_epi16(x, 1), m55));
+        __m256i even = _mm256_sub_epi8(_mm256_and_si256(t, m03), _mm256_and_si256(_mm256_srli_epi16(t, 2), m03));
+        __m256i odd = _mm256_sub_epi8(_mm256_and_si256(_mm256_srli_epi16(t, 4), m03), _mm256_and_si256(_mm256_srli_epi16(t, 6), m03));
+        // unpack lavora nelle due meta' da 128 bit: lo contiene i byte 0-7 e 16-23, hi i byte 8-15 e 24-31
+        __m256i lo = _mm256_unpacklo_epi8(even, odd);
+        __m256i hi = _mm256_unpackhi_epi8(even, odd);
+        StoreInt8x32(_mm256_castsi256_si128(lo), _mm256_castsi256_si128(hi), coeffs + i);
+        StoreInt8x32(_mm256_extracti128_si256(lo, 1), _mm256_extracti128_si256(hi, 1), coeffs + i + 32);
+    }
+    Cbd2Swar(buf, coeffs + i, n - i);
+}
+
+// eta = 3: 24 byte -> 32 coefficienti. Ogni gruppo di 3 byte va in una parola da 32 bit,
+// dove i 4 coefficienti sono calcolati insieme e poi spostati uno per byte
+__attribute__((target("avx2"))) inline void Cbd3AVX2(const uint8_t *buf, int32_t *coeffs, size_t n)
+{
+    // meta' bassa: byte 0-15, meta' alta: byte 12-27
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+    const __m256i spread = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                            0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m256i m249 = _mm256_set1_epi32(0x249249);
+    const __m256i m07 = _mm256_set1_epi8(0x07);
+    const size_t len = (3 * n) / 4;
+    size_t i = 0;
+    // la load da 32 byte ne usa 24: si ferma prima di leggere oltre il buffer
+    for (size_t off = 0; off + 32 <= len; i += 32, off += 24)
+    {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(buf + off));
+        x = _mm256_shuffle_epi8(_mm256_permutevar8x32_epi32(x, lanes), spread);
+        __m256i t = _mm256_add_epi32(_mm256_and_si256(x, m249), _mm256_and_si256(_mm256_srli_epi32(x, 1), m249));
+        t = _mm256_add_epi32(t, _mm256_and_si256(_mm256_srli_epi32(x, 2), m249));
+        __m256i bytes = _mm256_or_si256(_mm256_and_si256(t, _mm256_set1_epi32(0x3F)), _mm256_and_si256(_mm256_slli_epi32(t, 2), _mm256_set1_epi32(0x3F00)));
+        bytes = _mm256_or_si256(bytes, _mm256_and_si256(_mm256_slli_epi32(t, 4), _mm256_set1_epi32(0x3F0000)));
+        bytes = _mm256_or_si256(bytes, _mm256_and_si256(_mm256_slli_epi32(t, 6), _mm256_set1_epi32(0x3F000000)));
+        __m256i c = _mm256_sub_epi8(_mm256_and_si256(bytes, m07), _mm256_and_si256(_mm256_srli_epi32(bytes, 3), m07));
+        StoreInt8x32(_mm256_castsi256_si128(c), _mm256_extracti128_si256(c, 1), coeffs + i);
+    }
+    Cbd3Swar(buf + (3 * i) / 4, coeffs + i, n - i);
+}
+#endif
+
+inline void SampleCBD(const uint8_t *buf, uint8_t eta, int32_t *coeffs, size_t n)
+{
+#ifdef LWE_KEM_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2 && eta == 2)
+    {
+        Cbd2AVX2(buf, coeffs, n);
+        return;
+    }
+    if (avx2 && eta == 3)
+    {
+        Cbd3AVX2(buf, coeffs, n);
+        return;
+    }
+#endif
+    switch (eta)
+    {
+    case 1:
+        Cbd1Swar(buf, coeffs, n);
+        break;
+    case 2:
+        Cbd2Swar(buf, coeffs, n);
+        break;
+    case 3:
+        Cbd3Swar(buf, coeffs, n);
+        break;
+    default:
+        CbdGeneric(buf, eta, coeffs, n);
+    }
+}
+
+// Vettore CBD_eta deterministico: i byte vengono da PRF(seed, nonce) = SHAKE256(seed || nonce),
+// quindi lo stesso (seed, nonce) riproduce sempre lo stesso vettore
+inline std::vector<int32_t> SampleCBDVector(const PrfSeed &seed, uint8_t nonce, size_t n, uint8_t eta)
+{
+    uint8_t in[33];
+    std::copy(seed.begin(), seed.end(), in);
+    in[32] = nonce;
+    std::vector<uint8_t> buf((n * 2 * eta + 7) / 8);
+    lbcrypto::HashUtil::SHAKE256(in, sizeof(in), buf.data(), buf.size());
+
+    std::vector<int32_t> result(n);
+    SampleCBD(buf.data(), eta, result.data(), n);
+    return result;
+}
+
+inline std::vector<int32_t> sample_vector_binomial(uint32_t n, uint8_t eta)
+{
+    return SampleCBDVector(GenerateSeed<PrfSeed>(), 0, n, eta);
+}
+
+// Stato di lavoro di un thread per Encaps/Decaps (A e' m x n): i buffer sono allocati una
+// volta e riusati a ogni chiamata e il campionatore gaussiano e' risolto una volta sola.
+// Va creato dentro la regione parallela, uno per thread.
+struct KemWorkspace
+{
+    KemWorkspace(uint32_t n, uint32_t m, double stddev)
+        : prod(n), u(n), r(m), e1(n), acc(n), rows(4 * static_cast<size_t>(n)),
+          dgg(&GaussianSampler(stddev))
+    {
+    }
+
+    std::vector<int32_t> prod; // A^T * r
+    std::vector<int32_t> u;    // u ricalcolato dalla Decaps
+    int32_t v = 0;
+    std::vector<int32_t> r;    // rumore derivato da (m, H(pk)) per Encaps/Decaps
+    std::vector<int32_t> e1;
+    int32_t e2 = 0;
+    std::vector<int64_t, lbcrypto::AlignedAllocator<int64_t>> acc; // accumulatori di A^T * r in modalita' seed
+    std::vector<int32_t, lbcrypto::AlignedAllocator<int32_t>> rows; // 4 righe di A espanse da rho
+    const lbcrypto::DiscreteGaussianGeneratorImpl<lbcrypto::NativeVector> *dgg;
+};
+
+// A e' m x n: t = A*s + e ha m componenti, s ne ha n
+inline void KeyGen(uint32_t n, uint32_t m, uint32_t q, double stddev, MatrixInt32 &A, std::vector<int32_t> &s, std::vector<int32_t> &t, int32_t bound)
+{
+    A = GenerateRandomMatrixInt32(m, n, q - 1);
+    A.UpdateTranspose();
+    s = sample_vector_binomial(n, bound);
+    std::vector<int32_t> e = GenerateGaussianVector(m, q, stddev);
+    BarrettModulus modq(q);
+
+    t.assign(m, 0);
+    for (uint32_t i = 0; i < m; ++i)
+    {
+        t[i] = modq.Reduce(DotInt32(A.Row(i), s.data(), n) + e[i]);
+    }
+}
+
+// Come KeyGen, ma A non viene mai memorizzata: ogni riga e' espansa da rho,
+// usata per t_i = <A_i, s> + e_i e poi scartata.
+inline void KeyGen(uint32_t n, uint32_t m, uint32_t q, double stddev, SeededMatrix &A, std::vector<int32_t> &s, std::vector<int32_t> &t, int32_t bound)
+{
+    A = GenerateSeededMatrix(m, n, q);
+    s = sample_vector_binomial(n, bound);
+    std::vector<int32_t> e = GenerateGaussianVector(m, q, stddev);
+    BarrettModulus modq(q);
+
+    t.assign(m, 0);
+    ForEachMatrixRow(A, [&](uint32_t i, const int32_t *A_i)
+                     { t[i] = modq.Reduce(DotInt32(A_i, s.data(), n) + e[i]); });
+}
+
+// ws.prod = A^T * r mod q, usando le righe della trasposta memorizzata
+inline void TransposedProduct(const MatrixInt32 &A, const std::vector<int32_t> &r, uint32_t q, KemWorkspace &ws)
+{
+    const uint32_t n = A.Cols();
+    const uint32_t m = A.Rows();
+    BarrettModulus modq(q);
+    std::vector<int32_t> &prod = ws.prod;
+    prod.resize(n);
+
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        prod[i] = InnerProductModQ(A.TransposedRow(i), r.data(), m, modq);
+    }
+}
+
+// ws.prod = A^T * r mod q = sum_j r_j * A_j: le righe A_j sono espanse 4 alla volta in un
+// buffer da 16 KiB che resta in L1, quindi A non viene mai materializzata
+inline void TransposedProduct(const SeededMatrix &A, const std::vector<int32_t> &r, uint32_t q, KemWorkspace &ws)
+{
+    const uint32_t n = A.cols;
+    std::vector<int64_t, lbcrypto::AlignedAllocator<int64_t>> &acc = ws.acc;
+    acc.assign(n, 0);
+    ws.rows.resize(4 * static_cast<size_t>(n));
+    BarrettModulus modq(q);
+
+    ForEachMatrixRow(A, ws.rows.data(), [&](uint32_t j, const int32_t *A_j)
+                     { AxpyInt64(acc.data(), A_j, r[j], n); });
+
+    std::vector<int32_t> &prod = ws.prod;
+    prod.resize(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        prod[i] = modq.Reduce(acc[i]);
+    }
+}
+
+// Numero di vettori r trattati insieme in TransposedProductBatch: 16 vettori da
+// 1024 interi (64 KiB) restano in L1/L2 mentre si scorre A^T una sola volta
+constexpr size_t kBatchBlock = 16;
+
+// U = A^T * R mod q, con R = (r_0 | ... | r_{k-1}). Il prodotto e' a blocchi:
+// ogni riga di A^T viene letta una volta per blocco di kBatchBlock vettori invece
+// che una volta per vettore, e i prodotti scalari sono calcolati 4 alla volta.
+inline void TransposedProductBatch(const MatrixInt32 &A, const std::vector<std::vector<int32_t>> &R, uint32_t q, std::vector<std::vector<int32_t>> &U)
+{
+    const uint32_t n = A.Cols();
+    const uint32_t m = A.Rows();
+    const size_t k = R.size();
+    BarrettModulus modq(q);
+    U.assign(k, std::vector<int32_t>(n, 0));
+
+#pragma omp parallel for schedule(dynamic)
+    for (size_t lb = 0; lb < k; lb += kBatchBlock)
+    {
+        size_t lEnd = std::min(lb + kBatchBlock, k);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            const int32_t *At_i = A.TransposedRow(i);
+            size_t l = lb;
+            for (; l + 4 <= lEnd; l += 4)
+            {
+                const int32_t *b[4] = {R[l].data(), R[l + 1].data(), R[l + 2].data(), R[l + 3].data()};
+                int64_t dots[4];
+                Dot4Int32(At_i, b, m, dots);
+                for (size_t c = 0; c < 4; ++c)
+                {
+                    U[l + c][i] = modq.Reduce(dots[c]);
+                }
+            }
+            for (; l < lEnd; ++l)
+            {
+                U[l][i] = InnerProductModQ(At_i, R[l].data(), m, modq);
+            }
+        }
+    }
+}
+
+// Righe di A espanse insieme da TransposedProductBatch in modalita' seed (128 KiB per n = 1024)
+constexpr uint32_t kExpandChunk = 32;
+
+// In modalita' seed A e' espansa una sola volta, a blocchi di kExpandChunk righe: i thread
+// espandono gruppi di 4 righe diversi nel buffer del blocco, poi ognuno lo accumula nei propri
+// blocchi di kBatchBlock vettori, i cui accumulatori restano in L2. Una sola regione parallela
+// per tutto il prodotto, con due barriere per blocco di righe.
+inline void TransposedProductBatch(const SeededMatrix &A, const std::vector<std::vector<int32_t>> &R, uint32_t q, std::vector<std::vector<int32_t>> &U)
+{
+    const uint32_t n = A.cols;
+    const size_t k = R.size();
+    BarrettModulus modq(q);
+    std::vector<int64_t, lbcrypto::AlignedAllocator<int64_t>> acc(k * n, 0);
+    std::vector<int32_t, lbcrypto::AlignedAllocator<int32_t>> chunk(static_cast<size_t>(kExpandChunk) * n);
+    U.assign(k, std::vector<int32_t>(n, 0));
+
+#pragma omp parallel
+    {
+        for (uint32_t j0 = 0; j0 < A.rows; j0 += kExpandChunk)
+        {
+            const uint32_t chunkRows = std::min(kExpandChunk, A.rows - j0);
+#pragma omp for schedule(static)
+            for (uint32_t g = 0; g < chunkRows; g += 4)
+            {
+                int32_t *rows[4] = {&chunk[g * n], &chunk[(g + 1) * n], &chunk[(g + 2) * n], &chunk[(g + 3) * n]};
+                if (g + 4 <= chunkRows)
+                {
+                    ExpandMatrixRows4(A, j0 + g, rows);
+                    continue;
+                }
+                for (uint32_t l = 0; g + l < chunkRows; ++l)
+                {
+                    ExpandMatrixRow(A, j0 + g + l, rows[l]);
+                }
+            }
+#pragma omp for schedule(static)
+            for (size_t lb = 0; lb < k; lb += kBatchBlock)
+            {
+                const size_t lEnd = std::min(lb + kBatchBlock, k);
+                for (uint32_t j = 0; j < chunkRows; ++j)
+                {
+                    for (size_t l = lb; l < lEnd; ++l)
+                    {
+                        AxpyInt64(acc.data() + l * n, &chunk[j * n], R[l][j0 + j], n);
+                    }
+                }
+            }
+        }
+
+#pragma omp for
+        for (size_t l = 0; l < k; ++l)
+        {
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                U[l][i] = modq.Reduce(acc[l * n + i]);
+            }
+        }
+    }
+}
+
+// Compressione dei coefficienti di un ciphertext come Compress_d/Decompress_d di Kyber:
+// x in [0, q) -> round(2^d x / q) mod 2^d -> round(q y / 2^d). Con d = 12 (kUncompressedBits)
+// i coefficienti restano interi nella codifica a 12 bit.
+constexpr uint32_t kUncompressedBits = 12;
+
+constexpr size_t PackedBytes(size_t count, uint32_t d)
+{
+    return (count * d + 7) / 8;
+}
+
+// d fuori da [1, 12] non ha senso per un q a 12 bit (e con d = 0 Decompress scorrerebbe di -1)
+inline void CheckCompressionBits(uint32_t d, const char *what)
+{
+    if (d < 1 || d > kUncompressedBits)
+    {
+        throw std::invalid_argument(std::string(what) + ": d deve stare in [1, 12]");
+    }
+}
+
+// La divisione per q e' un prodotto per ceil(2^40 / q): per numeratori < 2^24 l'errore
+// resta sotto 1/q e il quoziente e' esatto
+template <typename Coeff>
+void Compress(const Coeff *in, size_t count, uint32_t q, uint32_t d, uint16_t *out)
+{
+    CheckCompressionBits(d, "Compress");
+    const uint64_t recip = ((uint64_t(1) << 40) + q - 1) / q;
+    const uint32_t mask = (1u << d) - 1;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint64_t num = (static_cast<uint64_t>(in[i]) << d) + q / 2;
+        out[i] = static_cast<uint16_t>((num * recip) >> 40 & mask);
+    }
+}
+
+template <typename Coeff>
+void Decompress(const uint16_t *in, size_t count, uint32_t q, uint32_t d, Coeff *out)
+{
+    CheckCompressionBits(d, "Decompress");
+    for (size_t i = 0; i < count; ++i)
+    {
+        out[i] = static_cast<Coeff>((static_cast<uint32_t>(in[i]) * q + (1u << (d - 1))) >> d);
+    }
+}
+
+// Formato del ciphertext del KEM: u con 11 bit per coefficiente, v con 6. Encrypt arrotonda gia'
+// u e v ai valori che la codifica compressa rappresenta esattamente, cosi' dopo la decodifica la
+// Decaps ricalcola gli stessi (u, v) e la codifica a 12 bit resta canonica.
+// Stima del tasso di errore di decifratura per sessione (n = m = 1024, sigma = 2.3, s CBD_3,
+// e2 in [-3, 3], margine q/4 = 832): senza compressione l'errore ha deviazione ~192 e il tasso
+// e' ~1.4e-5. Con (11, 6) si aggiungono s^T * du (deviazione ~18) e dv (al piu' +-26): ~1.8e-5.
+// I (10, 4) di Kyber sono troppo stretti per questi parametri: dv arriva a +-104 e il tasso sale
+// a ~4.4e-5 (6.3e-5 misurato), cioe' un errore in ~5% delle esecuzioni da 1024 sessioni.
+constexpr uint32_t kCiphertextDu = 11;
+constexpr uint32_t kCiphertextDv = 6;
+
+// coeffs <- Decompress_d(Compress_d(coeffs)), a blocchi sullo stack
+inline void CompressRoundTrip(int32_t *coeffs, size_t count, uint32_t q, uint32_t d)
+{
+    constexpr size_t kChunk = 256;
+    uint16_t tmp[kChunk];
+    for (size_t i = 0; i < count; i += kChunk)
+    {
+        size_t len = std::min(kChunk, count - i);
+        Compress(coeffs + i, len, q, d, tmp);
+        Decompress(tmp, len, q, d, coeffs + i);
+    }
+}
+
+template <typename PublicMatrix>
+void Encrypt(uint32_t n, uint32_t m, uint32_t q, double stddev, const PublicMatrix &A, const std::vector<int32_t> &t, std::vector<int32_t> &u, int32_t &v_i, uint32_t plaintext_i, const std::vector<int32_t> &r, const std::vector<int32_t> &e1, int32_t e2, KemWorkspace &ws)
+{
+    TransposedProduct(A, r, q, ws);
+    const std::vector<int32_t> &prod = ws.prod;
+
+    // u e v sono ridotti mod q e arrotondati al formato (kCiphertextDu, kCiphertextDv)
+    BarrettModulus modq(q);
+    u.resize(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        u[i] = modq.Reduce(prod[i] + e1[i]);
+    }
+    CompressRoundTrip(u.data(), n, q, kCiphertextDu);
+
+    int32_t risultato = InnerProductModQ(t.data(), r.data(), t.size(), modq);
+    v_i = modq.Reduce(static_cast<int64_t>(risultato) + e2 + plaintext_i);
+    CompressRoundTrip(&v_i, 1, q, kCiphertextDv);
+}
+
+// Senza salti dipendenti da s: m = q/2 se bound < mu <= q - bound, altrimenti 0
+inline void Decrypt(int32_t v_i, const std::vector<int32_t> &u, const std::vector<int32_t> &s, uint32_t q, int32_t &decrypt_i)
+{
+    const int32_t q_i = static_cast<int32_t>(q);
+    int32_t risultato = InnerProductModQ(s.data(), u.data(), s.size(), BarrettModulus(q));
+    int32_t mu = v_i - risultato;
+    mu += q_i & (mu >> 31);
+
+    int32_t bound = q_i / 4;
+    int32_t mask = ((bound - mu) >> 31) & ((mu - (q_i - bound) - 1) >> 31);
+
+    decrypt_i = (q_i / 2) & mask;
+}
+
+// Codifica canonica in byte, usata sia per gli hash sia come formato di trasmissione:
+// coefficienti in [0, q) con q <= 4096, impacchettati 2 ogni 3 byte (little-endian)
+constexpr size_t PackedBytes12(size_t count)
+{
+    return (count * 3 + 1) / 2;
+}
+
+template <typename Coeff>
+void Pack12Scalar(const Coeff *coeffs, size_t count, uint8_t *out)
+{
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        uint32_t c0 = static_cast<uint32_t>(coeffs[i]);
+        uint32_t c1 = static_cast<uint32_t>(coeffs[i + 1]);
+        out[0] = static_cast<uint8_t>(c0);
+        out[1] = static_cast<uint8_t>((c0 >> 8) | (c1 << 4));
+        out[2] = static_cast<uint8_t>(c1 >> 4);
+        out += 3;
+    }
+    if (i < count)
+    {
+        uint32_t c0 = static_cast<uint32_t>(coeffs[i]);
+        out[0] = static_cast<uint8_t>(c0);
+        out[1] = static_cast<uint8_t>(c0 >> 8);
+    }
+}
+
+template <typename Coeff>
+void Unpack12Scalar(const uint8_t *in, size_t count, Coeff *coeffs)
+{
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        coeffs[i] = static_cast<Coeff>(in[0] | ((in[1] & 0x0F) << 8));
+        coeffs[i + 1] = static_cast<Coeff>((in[1] >> 4) | (in[2] << 4));
+        in += 3;
+    }
+    if (i < count)
+    {
+        coeffs[i] = static_cast<Coeff>(in[0] | ((in[1] & 0x0F) << 8));
+    }
+}
+
+#ifdef LWE_KEM_X86
+__attribute__((target("avx2"))) inline __m256i Load8x32(const int32_t *p)
+{
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+__attribute__((target("avx2"))) inline __m256i Load8x32(const int16_t *p)
+{
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+}
+
+__attribute__((target("avx2"))) inline void Store8x32(int32_t *p, __m256i x)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), x);
+}
+
+__attribute__((target("avx2"))) inline void Store8x32(int16_t *p, __m256i x)
+{
+    // packs lavora per lane da 128 bit: i valori 0-3 e 4-7 finiscono nelle qword 0 e 2
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(x, x), 0x08);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm256_castsi256_si128(packed));
+}
+
+// 8 coefficienti -> 12 byte: ogni lane a 64 bit (c0, c1) diventa la parola a 24 bit
+// c0 | c1 << 12 e pshufb ne compatta i 3 byte bassi. Scrive 16 byte (4 di scarto).
+__attribute__((target("avx2"))) inline __m128i Pack12x8(__m256i x)
+{
+    const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+    const __m256i shuf = _mm256_setr_epi8(0, 1, 2, 8, 9, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                          0, 1, 2, 8, 9, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    __m256i w = _mm256_or_si256(_mm256_and_si256(x, low), _mm256_srli_epi64(x, 20));
+    w = _mm256_shuffle_epi8(w, shuf);
+    return _mm_or_si128(_mm256_castsi256_si128(w), _mm_slli_si128(_mm256_extracti128_si256(w, 1), 6));
+}
+
+// 12 byte -> 8 coefficienti: ogni lane a 32 bit riceve i 2 byte che contengono il suo
+// coefficiente, poi shift di 0 o 4 bit e maschera. Legge 16 byte.
+__attribute__((target("avx2"))) inline __m256i Unpack12x8(const uint8_t *in)
+{
+    const __m256i shuf = _mm256_setr_epi8(0, 1, -1, -1, 1, 2, -1, -1, 3, 4, -1, -1, 4, 5, -1, -1,
+                                          6, 7, -1, -1, 7, 8, -1, -1, 9, 10, -1, -1, 10, 11, -1, -1);
+    __m256i b = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+    __m256i x = _mm256_srlv_epi32(_mm256_shuffle_epi8(b, shuf), _mm256_setr_epi32(0, 4, 0, 4, 0, 4, 0, 4));
+    return _mm256_and_si256(x, _mm256_set1_epi32(0xFFF));
+}
+
+// Il ciclo vettoriale si ferma quando restano meno di 16 coefficienti (24 byte), cosi'
+// i 16 byte letti o scritti per blocco non escono mai dal buffer
+template <typename Coeff>
+__attribute__((target("avx2"))) inline void Pack12AVX2(const Coeff *coeffs, size_t count, uint8_t *out)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 8)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i / 2 * 3), Pack12x8(Load8x32(coeffs + i)));
+    }
+    Pack12Scalar(coeffs + i, count - i, out + i / 2 * 3);
+}
+
+template <typename Coeff>
+__attribute__((target("avx2"))) inline void Unpack12AVX2(const uint8_t *in, size_t count, Coeff *coeffs)
+{
+    size_t i = 0;
+    for (; i + 16 <= count; i += 8)
+    {
+        Store8x32(coeffs + i, Unpack12x8(in + i / 2 * 3));
+    }
+    Unpack12Scalar(in + i / 2 * 3, count - i, coeffs + i);
+}
+#endif
+
+template <typename Coeff>
+void Pack12(const Coeff *coeffs, size_t count, uint8_t *out)
+{
+#ifdef LWE_KEM_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2)
+    {
+        Pack12AVX2(coeffs, count, out);
+        return;
+    }
+#endif
+    Pack12Scalar(coeffs, count, out);
+}
+
+template <typename Coeff>
+void Unpack12(const uint8_t *in, size_t count, Coeff *coeffs)
+{
+#ifdef LWE_KEM_X86
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2)
+    {
+        Unpack12AVX2(in, count, coeffs);
+        return;
+    }
+#endif
+    Unpack12Scalar(in, count, coeffs);
+}
+
+// Valori di d bit impacchettati senza spazi, little-endian
+inline void PackBits(const uint16_t *in, size_t count, uint32_t d, uint8_t *out)
+{
+    uint64_t acc = 0;
+    uint32_t bits = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        acc |= static_cast<uint64_t>(in[i]) << bits;
+        bits += d;
+        while (bits >= 8)
+        {
+            *out++ = static_cast<uint8_t>(acc);
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits > 0)
+    {
+        *out = static_cast<uint8_t>(acc);
+    }
+}
+
+inline void UnpackBits(const uint8_t *in, size_t count, uint32_t d, uint16_t *out)
+{
+    const uint64_t mask = (uint64_t(1) << d) - 1;
+    uint64_t acc = 0;
+    uint32_t bits = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        while (bits < d)
+        {
+            acc |= static_cast<uint64_t>(*in++) << bits;
+            bits += 8;
+        }
+        out[i] = static_cast<uint16_t>(acc & mask);
+        acc >>= d;
+        bits -= d;
+    }
+}
+
+// Codifica di count coefficienti in [0, q) con d bit ciascuno (PackedBytes(count, d) byte).
+// Blocchi da 256 valori: 256 * d bit sono sempre un numero intero di byte.
+constexpr size_t kCompressChunk = 256;
+
+template <typename Coeff>
+void EncodeCompressed(const Coeff *coeffs, size_t count, uint32_t q, uint32_t d, uint8_t *out)
+{
+    if (d == kUncompressedBits)
+    {
+        Pack12(coeffs, count, out);
+        return;
+    }
+    uint16_t tmp[kCompressChunk];
+    for (size_t i = 0; i < count; i += kCompressChunk)
+    {
+        size_t len = std::min(kCompressChunk, count - i);
+        Compress(coeffs + i, len, q, d, tmp);
+        PackBits(tmp, len, d, out + PackedBytes(i, d));
+    }
+}
+
+template <typename Coeff>
+void DecodeCompressed(const uint8_t *in, size_t count, uint32_t q, uint32_t d, Coeff *coeffs)
+{
+    if (d == kUncompressedBits)
+    {
+        Unpack12(in, count, coeffs);
+        return;
+    }
+    uint16_t tmp[kCompressChunk];
+    for (size_t i = 0; i < count; i += kCompressChunk)
+    {
+        size_t len = std::min(kCompressChunk, count - i);
+        UnpackBits(in + PackedBytes(i, d), len, d, tmp);
+        Decompress(tmp, len, q, d, coeffs + i);
+    }
+}
+
+// Verifica che tutti i coefficienti decodificati stiano in [0, q)
+template <typename Coeff>
+void CheckCoefficients(const Coeff *coeffs, size_t count, uint32_t q, const char *what)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (static_cast<uint32_t>(coeffs[i]) >= q)
+        {
+            throw std::invalid_argument(std::string(what) + ": coefficiente fuori da [0, q)");
+        }
+    }
+}
+
+// pk = A || t, riga per riga
+inline std::vector<uint8_t> EncodePublicKey(const MatrixInt32 &A, const std::vector<int32_t> &t)
+{
+    const size_t rowBytes = PackedBytes12(A.Cols());
+    std::vector<uint8_t> out(A.Rows() * rowBytes + PackedBytes12(t.size()));
+    for (size_t i = 0; i < A.Rows(); ++i)
+    {
+        Pack12(A.Row(i), A.Cols(), out.data() + i * rowBytes);
+    }
+    Pack12(t.data(), t.size(), out.data() + A.Rows() * rowBytes);
+    return out;
+}
+
+// In modalita' seed la chiave pubblica e' rho || t
+inline std::vector<uint8_t> EncodePublicKey(const SeededMatrix &A, const std::vector<int32_t> &t)
+{
+    std::vector<uint8_t> out(A.rho.size() + PackedBytes12(t.size()));
+    std::copy(A.rho.begin(), A.rho.end(), out.begin());
+    Pack12(t.data(), t.size(), out.data() + A.rho.size());
+    return out;
+}
+
+// c = u || v, con v su 2 byte
+constexpr size_t CiphertextBytes(size_t n)
+{
+    return PackedBytes12(n) + 2;
+}
+
+inline void EncodeCiphertext(const std::vector<int32_t> &u, int32_t v_i, uint8_t *out)
+{
+    Pack12(u.data(), u.size(), out);
+    out[PackedBytes12(u.size())] = static_cast<uint8_t>(v_i);
+    out[PackedBytes12(u.size()) + 1] = static_cast<uint8_t>(v_i >> 8);
+}
+
+inline void DecodeCiphertext(const uint8_t *in, size_t n, std::vector<int32_t> &u, int32_t &v_i)
+{
+    u.resize(n);
+    Unpack12(in, n, u.data());
+    v_i = in[PackedBytes12(n)] | (in[PackedBytes12(n) + 1] << 8);
+}
+
+// Formato di trasmissione con compressione: u con du bit per coefficiente, v con dv bit.
+// Con du = dv = kUncompressedBits coincide con EncodeCiphertext qui sopra.
+constexpr size_t CiphertextBytes(size_t n, uint32_t du, uint32_t dv)
+{
+    return PackedBytes(n, du) + PackedBytes(1, dv);
+}
+
+inline void EncodeCiphertext(const std::vector<int32_t> &u, int32_t v_i, uint32_t q, uint32_t du, uint32_t dv, uint8_t *out)
+{
+    EncodeCompressed(u.data(), u.size(), q, du, out);
+    EncodeCompressed(&v_i, 1, q, dv, out + PackedBytes(u.size(), du));
+}
+
+// u e v decompressi sono vicini (entro q / 2^(d+1)) a quelli cifrati, non uguali
+inline void DecodeCiphertext(const uint8_t *in, size_t len, size_t n, uint32_t q, uint32_t du, uint32_t dv, std::vector<int32_t> &u, int32_t &v_i)
+{
+    CheckCompressionBits(du, "DecodeCiphertext");
+    CheckCompressionBits(dv, "DecodeCiphertext");
+    if (len != CiphertextBytes(n, du, dv))
+    {
+        throw std::invalid_argument("DecodeCiphertext: lunghezza della codifica errata");
+    }
+    u.resize(n);
+    DecodeCompressed(in, n, q, du, u.data());
+    DecodeCompressed(in + PackedBytes(n, du), 1, q, dv, &v_i);
+    CheckCoefficients(u.data(), n, q, "DecodeCiphertext");
+    CheckCoefficients(&v_i, 1, q, "DecodeCiphertext");
+}
+
+// s ha coefficienti piccoli (binomiali), codificati come s mod q a 12 bit
+constexpr size_t SecretKeyBytes(size_t n)
+{
+    return PackedBytes12(n);
+}
+
+inline std::vector<uint8_t> EncodeSecretKey(const std::vector<int32_t> &s, uint32_t q)
+{
+    std::vector<int32_t> reduced(s.size());
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+        reduced[i] = mod(s[i], q);
+    }
+    std::vector<uint8_t> out(SecretKeyBytes(s.size()));
+    Pack12(reduced.data(), reduced.size(), out.data());
+    return out;
+}
+
+inline void DecodeSecretKey(const uint8_t *in, size_t len, uint32_t n, uint32_t q, std::vector<int32_t> &s)
+{
+    if (len != SecretKeyBytes(n))
+    {
+        throw std::invalid_argument("DecodeSecretKey: lunghezza della codifica errata");
+    }
+    s.resize(n);
+    Unpack12(in, n, s.data());
+    CheckCoefficients(s.data(), n, q, "DecodeSecretKey");
+    const int32_t half = static_cast<int32_t>(q / 2);
+    for (int32_t &s_i : s)
+    {
+        s_i -= s_i > half ? static_cast<int32_t>(q) : 0;
+    }
+}
+
+// Impacchetta e accumula nell'hash un blocco di coefficienti alla volta, senza
+// materializzare la codifica completa
+template <typename Coeff>
+void HashPacked12(lbcrypto::SHA256Hasher &hasher, const Coeff *coeffs, size_t count)
+{
+    constexpr size_t kChunk = 256;
+    uint8_t buf[PackedBytes12(kChunk)];
+    for (size_t i = 0; i < count; i += kChunk)
+    {
+        size_t len = std::min(kChunk, count - i);
+        Pack12(coeffs + i, len, buf);
+        hasher.Update(buf, PackedBytes12(len));
+    }
+}
+
+// H(A || t), riga per riga
+inline lbcrypto::SHA256Digest HashPublicKey(const MatrixInt32 &A, const std::vector<int32_t> &t)
+{
+    lbcrypto::SHA256Hasher hasher;
+    for (size_t i = 0; i < A.Rows(); ++i)
+    {
+        HashPacked12(hasher, A.Row(i), A.Cols());
+    }
+    HashPacked12(hasher, t.data(), t.size());
+    return hasher.Final();
+}
+
+inline lbcrypto::SHA256Digest HashPublicKey(const SeededMatrix &A, const std::vector<int32_t> &t)
+{
+    lbcrypto::SHA256Hasher hasher;
+    hasher.Update(A.rho.data(), A.rho.size());
+    HashPacked12(hasher, t.data(), t.size());
+    return hasher.Final();
+}
+
+// Chiave pubblica (A, t) con H(pk) gia' calcolato: l'hash viene fatto una sola volta,
+// alla costruzione (KeyGen o caricamento), e riusato da ogni Encaps/Decaps
+template <typename PublicMatrix>
+struct KemPublicKey
+{
+    KemPublicKey() = default;
+
+    KemPublicKey(PublicMatrix matrix, std::vector<int32_t> vec)
+        : A(std::move(matrix)), t(std::move(vec)), hash(HashPublicKey(A, t))
+    {
+    }
+
+    PublicMatrix A;
+    std::vector<int32_t> t;
+    lbcrypto::SHA256Digest hash{};
+};
+
+// Chiave segreta: s e il seme z della chiave di rifiuto implicito, restituita dalla Decaps
+// al posto di K quando la ricifratura non coincide con il ciphertext ricevuto
+struct KemSecretKey
+{
+    std::vector<int32_t> s;
+    PrfSeed z{};
+};
+
+template <typename PublicMatrix>
+void KeyGen(uint32_t n, uint32_t m, uint32_t q, double stddev, KemPublicKey<PublicMatrix> &pk, KemSecretKey &sk, int32_t bound)
+{
+    PublicMatrix A;
+    std::vector<int32_t> t;
+    KeyGen(n, m, q, stddev, A, sk.s, t, bound);
+    sk.z = GenerateSeed<PrfSeed>();
+    pk = KemPublicKey<PublicMatrix>(std::move(A), std::move(t));
+}
+
+// Dimensioni fisse delle codifiche di EncodePublicKey (A e' m x n)
+constexpr size_t StoredPublicKeyBytes(size_t n, size_t m)
+{
+    return m * PackedBytes12(n) + PackedBytes12(m);
+}
+
+constexpr size_t SeededPublicKeyBytes(size_t m)
+{
+    return sizeof(MatrixSeed) + PackedBytes12(m);
+}
+
+template <typename PublicMatrix>
+std::vector<uint8_t> EncodePublicKey(const KemPublicKey<PublicMatrix> &pk)
+{
+    return EncodePublicKey(pk.A, pk.t);
+}
+
+// sk = s || z
+constexpr size_t KemSecretKeyBytes(size_t n)
+{
+    return SecretKeyBytes(n) + sizeof(PrfSeed);
+}
+
+inline std::vector<uint8_t> EncodeSecretKey(const KemSecretKey &sk, uint32_t q)
+{
+    std::vector<uint8_t> out = EncodeSecretKey(sk.s, q);
+    out.insert(out.end(), sk.z.begin(), sk.z.end());
+    return out;
+}
+
+inline void DecodeSecretKey(const uint8_t *in, size_t len, uint32_t n, uint32_t q, KemSecretKey &sk)
+{
+    if (len != KemSecretKeyBytes(n))
+    {
+        throw std::invalid_argument("DecodeSecretKey: lunghezza della codifica errata");
+    }
+    DecodeSecretKey(in, SecretKeyBytes(n), n, q, sk.s);
+    std::copy(in + SecretKeyBytes(n), in + len, sk.z.begin());
+}
+
+// Inverse di EncodePublicKey: n, m e q sono noti, quindi la lunghezza e' fissa; un input
+// di lunghezza diversa o con coefficienti >= q viene rifiutato. H(pk) e' ricalcolato.
+inline void DecodePublicKey(const uint8_t *in, size_t len, uint32_t n, uint32_t m, uint32_t q, KemPublicKey<MatrixInt32> &pk)
+{
+    if (len != StoredPublicKeyBytes(n, m))
+    {
+        throw std::invalid_argument("DecodePublicKey: lunghezza della codifica errata");
+    }
+    const size_t rowBytes = PackedBytes12(n);
+    MatrixInt32 A(m, n);
+    for (uint32_t i = 0; i < m; ++i)
+    {
+        Unpack12(in + i * rowBytes, n, A.Row(i));
+        CheckCoefficients(A.Row(i), n, q, "DecodePublicKey");
+    }
+    A.UpdateTranspose();
+    std::vector<int32_t> t(m);
+    Unpack12(in + m * rowBytes, m, t.data());
+    CheckCoefficients(t.data(), m, q, "DecodePublicKey");
+    pk = KemPublicKey<MatrixInt32>(std::move(A), std::move(t));
+}
+
+inline void DecodePublicKey(const uint8_t *in, size_t len, uint32_t n, uint32_t m, uint32_t q, KemPublicKey<SeededMatrix> &pk)
+{
+    if (len != SeededPublicKeyBytes(m))
+    {
+        throw std::invalid_argument("DecodePublicKey: lunghezza della codifica errata");
+    }
+    SeededMatrix A;
+    std::copy(in, in + A.rho.size(), A.rho.begin());
+    A.rows = m;
+    A.cols = n;
+    A.q = q;
+    std::vector<int32_t> t(m);
+    Unpack12(in + A.rho.size(), m, t.data());
+    CheckCoefficients(t.data(), m, q, "DecodePublicKey");
+    pk = KemPublicKey<SeededMatrix>(std::move(A), std::move(t));
+}
+
+// Confronto e selezione a tempo costante per il controllo di Fujisaki-Okamoto della Decaps:
+// il tempo non dipende ne' dalla posizione ne' dal numero delle differenze.
+// La barriera vuota impedisce al compilatore di riconoscere un valore 0/1 e ripristinare un salto.
+inline uint32_t ValueBarrier(uint32_t x)
+{
+#if defined(__GNUC__)
+    __asm__("" : "+r"(x));
+#endif
+    return x;
+}
+
+// 0xFFFFFFFF se a[0..len) == b[0..len), 0 altrimenti
+template <typename T>
+uint32_t CtEqualMask(const T *a, const T *b, size_t len)
+{
+    using U = std::make_unsigned_t<T>;
+    uint32_t diff = 0;
+    for (size_t i = 0; i < len; ++i)
+    {
+        diff |= static_cast<U>(a[i] ^ b[i]);
+    }
+    uint32_t differ = ValueBarrier((diff | (0u - diff)) >> 31);
+    return differ - 1;
+}
+
+// out = mask ? a : b, byte per byte senza salti (mask e' 0 o 0xFFFFFFFF)
+inline void CtSelect(uint8_t *out, const uint8_t *a, const uint8_t *b, size_t len, uint32_t mask)
+{
+    const uint8_t m8 = static_cast<uint8_t>(mask);
+    for (size_t i = 0; i < len; ++i)
+    {
+        out[i] = static_cast<uint8_t>(b[i] ^ (m8 & (a[i] ^ b[i])));
+    }
+}
+
+// H(pk) || m con m su 2 byte: ingresso sia di K_caps sia del seme del rumore della Encaps
+inline std::array<uint8_t, sizeof(lbcrypto::SHA256Digest) + 2> PlaintextInput(const lbcrypto::SHA256Digest &Hash_pk, uint32_t plaintext_i)
+{
+    std::array<uint8_t, sizeof(lbcrypto::SHA256Digest) + 2> buf;
+    std::copy(Hash_pk.begin(), Hash_pk.end(), buf.begin());
+    buf[Hash_pk.size()] = static_cast<uint8_t>(plaintext_i);
+    buf[Hash_pk.size() + 1] = static_cast<uint8_t>(plaintext_i >> 8);
+    return buf;
+}
+
+// H(c) con c = (u, v) nella codifica a 12 bit, calcolato direttamente su u e v senza
+// buffer per la codifica di c
+inline lbcrypto::SHA256Digest HashCiphertext(const std::vector<int32_t> &u, int32_t v_i)
+{
+    lbcrypto::SHA256Hasher hasher;
+    HashPacked12(hasher, u.data(), u.size());
+    uint8_t v_bytes[2] = {static_cast<uint8_t>(v_i), static_cast<uint8_t>(v_i >> 8)};
+    hasher.Update(v_bytes, sizeof(v_bytes));
+    return hasher.Final();
+}
+
+// H(key || H(c)): key e' K_caps per la chiave condivisa, z per la chiave di rifiuto
+inline lbcrypto::SHA256Digest HashWithCiphertext(const uint8_t *key, const lbcrypto::SHA256Digest &Hash_c)
+{
+    uint8_t buf[2 * sizeof(lbcrypto::SHA256Digest)];
+    std::copy(key, key + sizeof(lbcrypto::SHA256Digest), buf);
+    std::copy(Hash_c.begin(), Hash_c.end(), buf + sizeof(lbcrypto::SHA256Digest));
+    return lbcrypto::HashUtil::SHA256Bytes(buf, sizeof(buf));
+}
+
+// K = H(K_caps || H(c)), con K_caps = H(H(pk) || m) e c = (u, v) nella codifica a 12 bit
+inline lbcrypto::SHA256Digest DeriveSharedKey(const lbcrypto::SHA256Digest &Hash_pk, uint32_t plaintext_i, const std::vector<int32_t> &u, int32_t v_i)
+{
+    auto in = PlaintextInput(Hash_pk, plaintext_i);
+    lbcrypto::SHA256Digest K_caps = lbcrypto::HashUtil::SHA256Bytes(in.data(), in.size());
+    return HashWithCiphertext(K_caps.data(), HashCiphertext(u, v_i));
+}
+
+// Rumore di una sessione derivato in modo deterministico da (m, H(pk)), cosi' la Decaps
+// ricalcola esattamente (r, e1, e2): il seme del PRNG BLAKE2 e' SHA-512(H(pk) || m);
+// r ed e1 sono gaussiani (campionatore CDT), e2 e' uniforme in [-bound, bound]
+inline void DeriveEncapsNoise(const lbcrypto::DiscreteGaussianGeneratorImpl<lbcrypto::NativeVector> &dgg, const lbcrypto::SHA256Digest &Hash_pk, uint32_t plaintext_i, uint32_t n, uint32_t m, int32_t bound, std::vector<int32_t> &r, std::vector<int32_t> &e1, int32_t &e2)
+{
+    auto in = PlaintextInput(Hash_pk, plaintext_i);
+    lbcrypto::SHA512Digest G = lbcrypto::HashUtil::SHA512Bytes(in.data(), in.size());
+    default_prng::Blake2Engine::blake2_seed_array_t seed;
+    static_assert(sizeof(seed) == sizeof(G), "il seme BLAKE2 e' un digest SHA-512");
+    std::memcpy(seed.data(), G.data(), sizeof(G));
+    default_prng::Blake2Engine engine(seed, 0);
+
+    r.resize(m);
+    e1.resize(n);
+    dgg.GenerateIntVector(engine, r.data(), m);
+    dgg.GenerateIntVector(engine, e1.data(), n);
+    std::uniform_int_distribution<int32_t> dist(-bound, bound);
+    e2 = dist(engine);
+}
+
+template <typename PublicMatrix>
+void Encaps(uint32_t n, uint32_t m, uint32_t q, double stddev, int32_t bound, const KemPublicKey<PublicMatrix> &pk, std::vector<int32_t> &u, int32_t &v_i, int32_t plaintext_i, lbcrypto::SHA256Digest &Hash_K, KemWorkspace &ws)
+{
+    DeriveEncapsNoise(*ws.dgg, pk.hash, plaintext_i, n, m, bound, ws.r, ws.e1, ws.e2);
+    Encrypt(n, m, q, stddev, pk.A, pk.t, u, v_i, plaintext_i, ws.r, ws.e1, ws.e2, ws);
+
+    Hash_K = DeriveSharedKey(pk.hash, plaintext_i, u, v_i);
+}
+
+struct KemCiphertext
+{
+    std::vector<int32_t> u;
+    int32_t v = 0;
+};
+
+// Risultato di una sessione di EncapsBatch
+struct EncapsResult
+{
+    KemCiphertext c;
+    lbcrypto::SHA256Digest K{};
+};
+
+// Stessa derivazione di DeriveSharedKey per tutte le sessioni di un batch. I messaggi di
+// ogni passo hanno la stessa lunghezza, quindi vengono hashati insieme con SHA256Multi
+inline void DeriveSharedKeys(const lbcrypto::SHA256Digest &Hash_pk, const std::vector<uint32_t> &plaintexts, std::vector<EncapsResult> &results)
+{
+    const size_t k = results.size();
+    if (k == 0)
+    {
+        return;
+    }
+    const size_t cLen = CiphertextBytes(results[0].c.u.size());
+    std::vector<uint8_t> encoded(k * cLen);
+    std::vector<uint8_t> buf(k * 2 * sizeof(lbcrypto::SHA256Digest));
+    std::vector<const void *> messages(k);
+    std::vector<lbcrypto::SHA256Digest> K_caps(k), Hash_c(k);
+
+#pragma omp parallel for
+    for (size_t l = 0; l < k; ++l)
+    {
+        EncodeCiphertext(results[l].c.u, results[l].c.v, encoded.data() + l * cLen);
+        uint8_t *b = buf.data() + l * 2 * sizeof(lbcrypto::SHA256Digest);
+        std::copy(Hash_pk.begin(), Hash_pk.end(), b);
+        b[Hash_pk.size()] = static_cast<uint8_t>(plaintexts[l]);
+        b[Hash_pk.size() + 1] = static_cast<uint8_t>(plaintexts[l] >> 8);
+    }
+
+    for (size_t l = 0; l < k; ++l)
+    {
+        messages[l] = buf.data() + l * 2 * sizeof(lbcrypto::SHA256Digest);
+    }
+    lbcrypto::HashUtil::SHA256Multi(messages.data(), Hash_pk.size() + 2, k, K_caps.data());
+
+    for (size_t l = 0; l < k; ++l)
+    {
+        messages[l] = encoded.data() + l * cLen;
+    }
+    lbcrypto::HashUtil::SHA256Multi(messages.data(), cLen, k, Hash_c.data());
+
+    for (size_t l = 0; l < k; ++l)
+    {
+        uint8_t *b = buf.data() + l * 2 * sizeof(lbcrypto::SHA256Digest);
+        std::copy(K_caps[l].begin(), K_caps[l].end(), b);
+        std::copy(Hash_c[l].begin(), Hash_c[l].end(), b + sizeof(lbcrypto::SHA256Digest));
+        messages[l] = b;
+    }
+    std::vector<lbcrypto::SHA256Digest> K(k);
+    lbcrypto::HashUtil::SHA256Multi(messages.data(), 2 * sizeof(lbcrypto::SHA256Digest), k, K.data());
+    for (size_t l = 0; l < k; ++l)
+    {
+        results[l].K = K[l];
+    }
+}
+
+// Incapsula k = plaintexts.size() messaggi con la stessa chiave pubblica: A^T * R e'
+// un unico prodotto matrice-matrice a blocchi
+template <typename PublicMatrix>
+std::vector<EncapsResult> EncapsBatch(uint32_t n, uint32_t m, uint32_t q, double stddev, int32_t bound, const KemPublicKey<PublicMatrix> &pk, const std::vector<uint32_t> &plaintexts)
+{
+    const PublicMatrix &A = pk.A;
+    const std::vector<int32_t> &t = pk.t;
+    const size_t k = plaintexts.size();
+    std::vector<EncapsResult> results(k);
+    std::vector<std::vector<int32_t>> R(k), E1(k);
+    std::vector<int32_t> E2(k);
+    const lbcrypto::DiscreteGaussianGeneratorImpl<lbcrypto::NativeVector> &dgg = GaussianSampler(stddev);
+
+#pragma omp parallel for
+    for (size_t l = 0; l < k; ++l)
+    {
+        DeriveEncapsNoise(dgg, pk.hash, plaintexts[l], n, m, bound, R[l], E1[l], E2[l]);
+    }
+
+    std::vector<std::vector<int32_t>> U;
+    TransposedProductBatch(A, R, q, U);
+
+    BarrettModulus modq(q);
+
+#pragma omp parallel for
+    for (size_t l = 0; l < k; ++l)
+    {
+        EncapsResult &res = results[l];
+        res.c.u.resize(n);
+        for (uint32_t i = 0; i < n; ++i)
+        {
+            res.c.u[i] = modq.Reduce(U[l][i] + E1[l][i]);
+        }
+        CompressRoundTrip(res.c.u.data(), n, q, kCiphertextDu);
+        res.c.v = modq.Reduce(static_cast<int64_t>(InnerProductModQ(t.data(), R[l].data(), t.size(), modq)) + E2[l] + plaintexts[l]);
+        CompressRoundTrip(&res.c.v, 1, q, kCiphertextDv);
+    }
+
+    DeriveSharedKeys(pk.hash, plaintexts, results);
+
+    return results;
+}
+
+// Decaps con il controllo di Fujisaki-Okamoto: decifra m', ricalcola (r, e1, e2) da
+// (m', H(pk)), ricifra e confronta (u', v') con (u, v) a tempo costante. Se coincidono
+// K = H(K_caps' || H(c)), altrimenti K = H(z || H(c)) (rifiuto implicito): la scelta e' una
+// selezione senza salti, quindi un ciphertext manipolato non si riconosce dal tempo.
+// (u, v) puo' arrivare dalla codifica a 12 bit o da quella compressa con (kCiphertextDu,
+// kCiphertextDv): Encrypt produce gia' valori arrotondati a quel formato.
+template <typename PublicMatrix>
+void Decaps(int32_t v_i, const std::vector<int32_t> &u, const KemSecretKey &sk, uint32_t q, const KemPublicKey<PublicMatrix> &pk, uint32_t n, uint32_t m, double stddev, int32_t bound, lbcrypto::SHA256Digest &Hash_K, KemWorkspace &ws)
+{
+    if (u.size() != n)
+    {
+        throw std::invalid_argument("Decaps: u deve avere n componenti");
+    }
+    int32_t m_dec;
+    Decrypt(v_i, u, sk.s, q, m_dec);
+
+    // la ricifratura scrive nei buffer del workspace: nessuna allocazione
+    DeriveEncapsNoise(*ws.dgg, pk.hash, m_dec, n, m, bound, ws.r, ws.e1, ws.e2);
+    Encrypt(n, m, q, stddev, pk.A, pk.t, ws.u, ws.v, m_dec, ws.r, ws.e1, ws.e2, ws);
+    uint32_t equal = CtEqualMask(ws.u.data(), u.data(), n) & CtEqualMask(&ws.v, &v_i, 1);
+
+    lbcrypto::SHA256Digest Hash_c = HashCiphertext(u, v_i);
+    auto in = PlaintextInput(pk.hash, m_dec);
+    lbcrypto::SHA256Digest K_good = HashWithCiphertext(lbcrypto::HashUtil::SHA256Bytes(in.data(), in.size()).data(), Hash_c);
+    lbcrypto::SHA256Digest K_bad = HashWithCiphertext(sk.z.data(), Hash_c);
+    CtSelect(Hash_K.data(), K_good.data(), K_bad.data(), Hash_K.size(), equal);
+}
+
+// KeyGen + Encaps/Decaps di tutti i bit del plaintext; PublicMatrix sceglie se A
+// e' memorizzata (MatrixInt32) o rigenerata dal seed rho (SeededMatrix).
+// Restituisce il numero di sessioni in cui la chiave della Decaps differisce da quella della
+// Encaps: con ~1.8e-5 errori per sessione (vedi kCiphertextDu) capita in ~2% delle esecuzioni
+// da 1024 sessioni, quindi e' un dato da riportare e non un errore.
+template <typename PublicMatrix>
+size_t RunKem(uint32_t n, uint32_t m, uint32_t q, double stddev, int bound, const std::vector<uint32_t> &plaintext)
+{
+    KemSecretKey sk;
+
+    KemPublicKey<PublicMatrix> pk;
+
+    KeyGen(n, m, q, stddev, pk, sk, bound);
+
+    std::vector<EncapsResult> sessions = EncapsBatch(n, m, q, stddev, bound, pk, plaintext);
+
+    // ogni thread ha il proprio KemWorkspace; l'unico stato condiviso scritto e' K_dec[i]
+    std::vector<lbcrypto::SHA256Digest> K_dec(plaintext.size());
+#pragma omp parallel
+    {
+        KemWorkspace ws(n, m, stddev);
+#pragma omp for
+        for (uint32_t i = 0; i < plaintext.size(); ++i)
+        {
+            const EncapsResult &ses = sessions[i];
+            Decaps(ses.c.v, ses.c.u, sk, q, pk, n, m, stddev, bound, K_dec[i], ws);
+        }
+    }
+
+    size_t mismatches = 0;
+    for (uint32_t i = 0; i < plaintext.size(); ++i)
+    {
+        mismatches += K_dec[i] != sessions[i].K;
+    }
+    return mismatches;
+}
+
+// ---------------------------------------------------------------------------------------
+// Variante Module-LWE: s, e, r sono vettori di k polinomi in R_q = Z_q[X]/(X^256 + 1) e A e'
+// una matrice k x k di polinomi, quindi ogni prodotto costa O(k^2 n log n) invece di O(n m).
+// q = 3329 ha solo radici 256-esime dell'unita', quindi la NTT e' incompleta (IncompleteNTT16):
+// un polinomio nel dominio NTT e' fatto di 128 polinomi di grado 1 e il prodotto e' la
+// moltiplicazione base-case. I polinomi sono Poly16: coefficienti int16_t in [0, q).
+constexpr uint32_t kMlweN = 256;
+constexpr uint32_t kMlweQ = 3329;
+constexpr uint8_t kMlweEta = 2;
+constexpr size_t kMlweMsgBytes = kMlweN / 8;
+
+using MlwePoly = lbcrypto::Poly16;
+
+struct MlweParams
+{
+    MlweParams(uint32_t k, uint32_t q = kMlweQ, uint8_t eta = kMlweEta)
+        : k(k), q(q), eta(eta), du(k == 4 ? 11 : 10), dv(k == 4 ? 5 : 4), ring(std::make_shared<const intnat::IncompleteNTT16>(kMlweN, static_cast<uint16_t>(q)))
+    {
+        if (k < 1 || k > 4)
+        {
+            throw std::invalid_argument("MlweParams: k deve essere 1, 2, 3 o 4");
+        }
+    }
+
+    uint32_t k;
+    uint32_t q;
+    uint8_t eta;
+    // bit per coefficiente di u e v nel ciphertext (Compress_du, Compress_dv), come in Kyber
+    uint32_t du;
+    uint32_t dv;
+    std::shared_ptr<const intnat::IncompleteNTT16> ring;
+};
+
+// A (k x k, riga per riga) e t sono nel dominio NTT, in [0, q); A e' espansa da rho una volta
+// sola e tenuta insieme alla chiave, quindi non fa parte della codifica
+struct MlwePublicKey
+{
+    MatrixSeed rho{};
+    std::vector<MlwePoly> A;
+    std::vector<MlwePoly> t;
+    lbcrypto::SHA256Digest hash{};
+};
+
+// s nel dominio NTT; z e' il seme della chiave di rifiuto implicito
+struct MlweSecretKey
+{
+    std::vector<MlwePoly> s;
+    PrfSeed z{};
+};
+
+// u e v nel dominio dei coefficienti, in [0, q), gia' arrotondati da Compress/Decompress:
+// sono esattamente i valori che il destinatario decodifica
+struct MlweCiphertext
+{
+    std::vector<MlwePoly> u;
+    MlwePoly v;
+};
+
+// A[i][j] = valori a 12 bit < q da SHAKE128(rho || j || i), come in Kyber. La distribuzione
+// uniforme e' invariante per NTT, quindi sono gia' i valori nel dominio NTT.
+inline void ExpandMlweEntry(const MlweParams &params, const MatrixSeed &rho, uint8_t i, uint8_t j, MlwePoly &a)
+{
+    uint8_t in[34];
+    std::copy(rho.begin(), rho.end(), in);
+    in[32] = j;
+    in[33] = i;
+    lbcrypto::KeccakHasher xof(lbcrypto::SHAKE_128);
+    xof.Update(in, sizeof(in));
+
+    uint8_t buf[kShake128Rate];
+    intnat::NativeVector16 values(kMlweN, static_cast<uint16_t>(params.q));
+    size_t filled = 0;
+    while (filled < kMlweN)
+    {
+        xof.Squeeze(buf, sizeof(buf));
+        ParseUniform12(buf, sizeof(buf), params.q, values.data(), filled, kMlweN);
+    }
+    a = MlwePoly(params.ring, Format::EVALUATION);
+    a.SetValues(std::move(values), Format::EVALUATION);
+}
+
+// Polinomio CBD_eta da PRF(seed, nonce), nel dominio dei coefficienti
+inline void SampleCBDPoly(const MlweParams &params, const PrfSeed &seed, uint8_t nonce, MlwePoly &p)
+{
+    std::vector<int32_t> c = SampleCBDVector(seed, nonce, kMlweN, params.eta);
+    intnat::NativeVector16 values(kMlweN, static_cast<uint16_t>(params.q));
+    std::copy(c.begin(), c.end(), values.data());
+    p = MlwePoly(params.ring, Format::COEFFICIENT);
+    p.SetValues(std::move(values), Format::COEFFICIENT);
+}
+
+// acc = sum_j a_j * b_j nel dominio NTT; a_j = a[j * stride], b_j = b[j]
+inline void MlweInnerProduct(const MlweParams &params, const MlwePoly *a, size_t stride, const MlwePoly *b, MlwePoly &acc)
+{
+    acc = a[0] * b[0];
+    for (uint32_t j = 1; j < params.k; ++j)
+    {
+        acc.AddProductEq(a[j * stride], b[j]);
+    }
+}
+
+// H(pk) = SHA-256(rho || t), t nella codifica a 12 bit
+inline lbcrypto::SHA256Digest HashPublicKey(const MlwePublicKey &pk)
+{
+    lbcrypto::SHA256Hasher hasher;
+    hasher.Update(pk.rho.data(), pk.rho.size());
+    for (const MlwePoly &t_i : pk.t)
+    {
+        HashPacked12(hasher, t_i.GetValues().data(), kMlweN);
+    }
+    return hasher.Final();
+}
+
+// Dimensioni fisse delle codifiche: pk = rho || t e sk = s (nel dominio NTT, 12 bit) || z,
+// c = Compress_du(u) || Compress_dv(v)
+inline size_t MlwePublicKeyBytes(const MlweParams &params)
+{
+    return sizeof(MatrixSeed) + params.k * PackedBytes12(kMlweN);
+}
+
+// sk = s || z
+inline size_t MlweSecretKeyBytes(const MlweParams &params)
+{
+    return params.k * PackedBytes12(kMlweN) + sizeof(PrfSeed);
+}
+
+inline size_t MlweCiphertextBytes(const MlweParams &params)
+{
+    return params.k * PackedBytes(kMlweN, params.du) + PackedBytes(kMlweN, params.dv);
+}
+
+// k <= 4 e d <= 12
+constexpr size_t kMaxMlweCiphertextBytes = 5 * PackedBytes12(kMlweN);
+
+inline void EncodeMlweCiphertext(const MlweParams &params, const MlweCiphertext &c, uint8_t *out)
+{
+    const size_t polyBytes = PackedBytes(kMlweN, params.du);
+    for (uint32_t i = 0; i < params.k; ++i)
+    {
+        EncodeCompressed(c.u[i].GetValues().data(), kMlweN, params.q, params.du, out + i * polyBytes);
+    }
+    EncodeCompressed(c.v.GetValues().data(), kMlweN, params.q, params.dv, out + params.k * polyBytes);
+}
+
+// Il polinomio da n valori codificati con d bit, nel formato dato
+inline void DecodeMlwePoly(const MlweParams &params, const uint8_t *in, uint32_t d, Format format, MlwePoly &p, const char *what)
+{
+    intnat::NativeVector16 values(kMlweN, static_cast<uint16_t>(params.q));
+    DecodeCompressed(in, kMlweN, params.q, d, values.data());
+    CheckCoefficients(values.data(), kMlweN, params.q, what);
+    p = MlwePoly(params.ring, format);
+    p.SetValues(std::move(values), format);
+}
+
+inline void DecodeMlweCiphertext(const MlweParams &params, const uint8_t *in, size_t len, MlweCiphertext &c)
+{
+    if (len != MlweCiphertextBytes(params))
+    {
+        throw std::invalid_argument("DecodeMlweCiphertext: lunghezza della codifica errata");
+    }
+    const size_t polyBytes = PackedBytes(kMlweN, params.du);
+    c.u.resize(params.k);
+    for (uint32_t i = 0; i < params.k; ++i)
+    {
+        DecodeMlwePoly(params, in + i * polyBytes, params.du, Format::COEFFICIENT, c.u[i], "DecodeMlweCiphertext");
+    }
+    DecodeMlwePoly(params, in + params.k * polyBytes, params.dv, Format::COEFFICIENT, c.v, "DecodeMlweCiphertext");
+}
+
+// H(c) sulla codifica compressa, cioe' sui byte trasmessi
+inline lbcrypto::SHA256Digest HashCiphertext(const MlweParams &params, const MlweCiphertext &c)
+{
+    uint8_t buf[kMaxMlweCiphertextBytes];
+    EncodeMlweCiphertext(params, c, buf);
+    return lbcrypto::HashUtil::SHA256Bytes(buf, MlweCiphertextBytes(params));
+}
+
+// Arrotonda p a Decompress_d(Compress_d(p)), i valori ricostruiti dal destinatario
+inline void CompressRoundTrip(const MlweParams &params, uint32_t d, MlwePoly &p)
+{
+    if (d == kUncompressedBits)
+    {
+        return;
+    }
+    uint16_t tmp[kMlweN];
+    Compress(&p[0], kMlweN, params.q, d, tmp);
+    Decompress(tmp, kMlweN, params.q, d, &p[0]);
+}
+
+// t = A s + e con s, e ~ CBD_eta da un seme sigma casuale
+inline void ExpandMlweMatrix(const MlweParams &params, MlwePublicKey &pk)
+{
+    const uint32_t k = params.k;
+    pk.A.resize(k * k);
+    for (uint32_t i = 0; i < k; ++i)
+    {
+        for (uint32_t j = 0; j < k; ++j)
+        {
+            ExpandMlweEntry(params, pk.rho, i, j, pk.A[i * k + j]);
+        }
+    }
+}
+
+inline void MlweKeyGen(const MlweParams &params, MlwePublicKey &pk, MlweSecretKey &sk)
+{
+    const uint32_t k = params.k;
+    pk.rho = GenerateSeed<MatrixSeed>();
+    PrfSeed sigma = GenerateSeed<PrfSeed>();
+    sk.z = GenerateSeed<PrfSeed>();
+    ExpandMlweMatrix(params, pk);
+
+    sk.s.resize(k);
+    for (uint32_t j = 0; j < k; ++j)
+    {
+        SampleCBDPoly(params, sigma, j, sk.s[j]);
+        sk.s[j].SwitchFormat();
+    }
+
+    pk.t.resize(k);
+    for (uint32_t i = 0; i < k; ++i)
+    {
+        MlwePoly e;
+        SampleCBDPoly(params, sigma, k + i, e);
+        e.SwitchFormat();
+        MlweInnerProduct(params, &pk.A[i * k], 1, sk.s.data(), pk.t[i]);
+        pk.t[i] += e;
+    }
+    pk.hash = HashPublicKey(pk);
+}
+
+inline std::vector<uint8_t> EncodeMlwePublicKey(const MlweParams &params, const MlwePublicKey &pk)
+{
+    std::vector<uint8_t> out(MlwePublicKeyBytes(params));
+    std::copy(pk.rho.begin(), pk.rho.end(), out.begin());
+    for (uint32_t i = 0; i < params.k; ++i)
+    {
+        Pack12(pk.t[i].GetValues().data(), kMlweN, out.data() + pk.rho.size() + i * PackedBytes12(kMlweN));
+    }
+    return out;
+}
+
+// A viene riespansa da rho e H(pk) ricalcolato
+inline void DecodeMlwePublicKey(const MlweParams &params, const uint8_t *in, size_t len, MlwePublicKey &pk)
+{
+    if (len != MlwePublicKeyBytes(params))
+    {
+        throw std::invalid_argument("DecodeMlwePublicKey: lunghezza della codifica errata");
+    }
+    std::copy(in, in + pk.rho.size(), pk.rho.begin());
+    pk.t.resize(params.k);
+    for (uint32_t i = 0; i < params.k; ++i)
+    {
+        DecodeMlwePoly(params, in + pk.rho.size() + i * PackedBytes12(kMlweN), kUncompressedBits, Format::EVALUATION,
+                       pk.t[i], "DecodeMlwePublicKey");
+    }
+    ExpandMlweMatrix(params, pk);
+    pk.hash = HashPublicKey(pk);
+}
+
+inline std::vector<uint8_t> EncodeMlweSecretKey(const MlweParams &params, const MlweSecretKey &sk)
+{
+    std::vector<uint8_t> out(MlweSecretKeyBytes(params));
+    for (uint32_t i = 0; i < params.k; ++i)
+    {
+        Pack12(sk.s[i].GetValues().data(), kMlweN, out.data() + i * PackedBytes12(kMlweN));
+    }
+    std::copy(sk.z.begin(), sk.z.end(), out.begin() + params.k * PackedBytes12(kMlweN));
+    return out;
+}
+
+inline void DecodeMlweSecretKey(const MlweParams &params, const uint8_t *in, size_t len, MlweSecretKey &sk)
+{
+    if (len != MlweSecretKeyBytes(params))
+    {
+        throw std::invalid_argument("DecodeMlweSecretKey: lunghezza della codifica errata");
+    }
+    sk.s.resize(params.k);
+    for (uint32_t i = 0; i < params.k; ++i)
+    {
+        DecodeMlwePoly(params, in + i * PackedBytes12(kMlweN), kUncompressedBits, Format::EVALUATION, sk.s[i],
+                       "DecodeMlweSecretKey");
+    }
+    const uint8_t *z = in + params.k * PackedBytes12(kMlweN);
+    std::copy(z, z + sk.z.size(), sk.z.begin());
+}
+
+// Cifratura deterministica di un messaggio da 256 bit con i coins dati:
+// u = A^T r + e1, v = t^T r + e2 + round(q/2) * m
+inline void MlweEncrypt(const MlweParams &params, const MlwePublicKey &pk, const uint8_t *msg, const PrfSeed &coins, MlweCiphertext &c)
+{
+    const uint32_t k = params.k;
+    std::vector<MlwePoly> r(k);
+    for (uint32_t j = 0; j < k; ++j)
+    {
+        SampleCBDPoly(params, coins, j, r[j]);
+        r[j].SwitchFormat();
+    }
+
+    MlwePoly noise;
+    c.u.resize(k);
+    for (uint32_t i = 0; i < k; ++i)
+    {
+        // colonna i di A = elementi i, i + k, i + 2k, ...
+        MlweInnerProduct(params, &pk.A[i], k, r.data(), c.u[i]);
+        c.u[i].SwitchFormat();
+        SampleCBDPoly(params, coins, k + i, noise);
+        c.u[i] += noise;
+        CompressRoundTrip(params, params.du, c.u[i]);
+    }
+
+    MlweInnerProduct(params, pk.t.data(), 1, r.data(), c.v);
+    c.v.SwitchFormat();
+    SampleCBDPoly(params, coins, 2 * k, noise);
+    const int16_t half = static_cast<int16_t>((params.q + 1) / 2);
+    for (uint32_t i = 0; i < kMlweN; ++i)
+    {
+        noise.ModAddAtIndex(i, half * ((msg[i / 8] >> (i % 8)) & 1));
+    }
+    c.v += noise;
+    CompressRoundTrip(params, params.dv, c.v);
+}
+
+// m_i = 1 se v - s^T u e' piu' vicino a q/2 che a 0
+inline void MlweDecrypt(const MlweParams &params, const MlweSecretKey &sk, const MlweCiphertext &c, uint8_t *msg)
+{
+    std::vector<MlwePoly> u_hat(c.u);
+    for (MlwePoly &u_j : u_hat)
+    {
+        u_j.SwitchFormat();
+    }
+    MlwePoly w;
+    MlweInnerProduct(params, sk.s.data(), 1, u_hat.data(), w);
+    w.SwitchFormat();
+    w = c.v - w;
+
+    std::fill(msg, msg + kMlweMsgBytes, 0);
+    for (uint32_t i = 0; i < kMlweN; ++i)
+    {
+        uint32_t x = static_cast<uint32_t>(w[i]);
+        uint32_t bit = ((x << 1) + params.q / 2) / params.q & 1;
+        msg[i / 8] |= static_cast<uint8_t>(bit << (i % 8));
+    }
+}
+
+// (K_bar, coins) = SHA-512(H(pk) || m), K = SHA-256(K_bar || H(c)), come in Kyber
+inline lbcrypto::SHA512Digest MlweDeriveCoins(const lbcrypto::SHA256Digest &Hash_pk, const uint8_t *msg)
+{
+    uint8_t buf[sizeof(lbcrypto::SHA256Digest) + kMlweMsgBytes];
+    std::copy(Hash_pk.begin(), Hash_pk.end(), buf);
+    std::copy(msg, msg + kMlweMsgBytes, buf + Hash_pk.size());
+    return lbcrypto::HashUtil::SHA512Bytes(buf, sizeof(buf));
+}
+
+inline lbcrypto::SHA256Digest MlweSharedKey(const MlweParams &params, const lbcrypto::SHA512Digest &G, const MlweCiphertext &c)
+{
+    return HashWithCiphertext(G.data(), HashCiphertext(params, c));
+}
+
+inline void MlweEncaps(const MlweParams &params, const MlwePublicKey &pk, MlweCiphertext &c, lbcrypto::SHA256Digest &K)
+{
+    auto m = GenerateSeed<std::array<uint8_t, kMlweMsgBytes>>();
+    lbcrypto::SHA512Digest G = MlweDeriveCoins(pk.hash, m.data());
+    PrfSeed coins;
+    std::copy(G.begin() + coins.size(), G.end(), coins.begin());
+    MlweEncrypt(params, pk, m.data(), coins, c);
+    K = MlweSharedKey(params, G, c);
+}
+
+// Decifra, ricifra con i coins derivati da m' e confronta le codifiche di c e della
+// ricifratura a tempo costante; K = H(K_bar || H(c)) se coincidono, altrimenti la chiave
+// di rifiuto implicito H(z || H(c)), scelta senza salti. L'esito del confronto non esce dalla
+// funzione: un ciphertext rifiutato si riconosce solo perche' K e' diversa da quella della Encaps.
+inline void MlweDecaps(const MlweParams &params, const MlwePublicKey &pk, const MlweSecretKey &sk, const MlweCiphertext &c, lbcrypto::SHA256Digest &K)
+{
+    uint8_t m[kMlweMsgBytes];
+    MlweDecrypt(params, sk, c, m);
+    lbcrypto::SHA512Digest G = MlweDeriveCoins(pk.hash, m);
+    PrfSeed coins;
+    std::copy(G.begin() + coins.size(), G.end(), coins.begin());
+
+    MlweCiphertext c_new;
+    MlweEncrypt(params, pk, m, coins, c_new);
+
+    const size_t len = MlweCiphertextBytes(params);
+    uint8_t received[kMaxMlweCiphertextBytes], reencrypted[kMaxMlweCiphertextBytes];
+    EncodeMlweCiphertext(params, c, received);
+    EncodeMlweCiphertext(params, c_new, reencrypted);
+    uint32_t equal = CtEqualMask(received, reencrypted, len);
+
+    lbcrypto::SHA256Digest Hash_c = lbcrypto::HashUtil::SHA256Bytes(received, len);
+    lbcrypto::SHA256Digest K_good = HashWithCiphertext(G.data(), Hash_c);
+    lbcrypto::SHA256Digest K_bad = HashWithCiphertext(sk.z.data(), Hash_c);
+    CtSelect(K.data(), K_good.data(), K_bad.data(), K.size(), equal);
+}
+
+// KeyGen + sessions Encaps/Decaps con la variante Module-LWE di rango k. Con i parametri di
+// Kyber il tasso di errore di decifratura e' trascurabile (< 2^-130), quindi una chiave
+// diversa e' un errore dell'implementazione e non un errore di decifratura atteso come in RunKem.
+inline void RunMlweKem(uint32_t k, size_t sessions)
+{
+    MlweParams params(k);
+    MlwePublicKey pk;
+    MlweSecretKey sk;
+    MlweKeyGen(params, pk, sk);
+
+    std::vector<MlweCiphertext> c(sessions);
+    std::vector<lbcrypto::SHA256Digest> K(sessions), K_dec(sessions);
+#pragma omp parallel for
+    for (size_t i = 0; i < sessions; ++i)
+    {
+        MlweEncaps(params, pk, c[i], K[i]);
+    }
+#pragma omp parallel for
+    for (size_t i = 0; i < sessions; ++i)
+    {
+        MlweDecaps(params, pk, sk, c[i], K_dec[i]);
+    }
+
+    size_t mismatches = 0;
+    for (size_t i = 0; i < sessions; ++i)
+    {
+        mismatches += K_dec[i] != K[i];
+    }
+    if (mismatches > 0)
+    {
+        throw std::runtime_error("RunMlweKem: " + std::to_string(mismatches) + " sessioni su " + std::to_string(sessions) + " con chiave della Decaps diversa da quella della Encaps");
+    }
+}
+
+#endif
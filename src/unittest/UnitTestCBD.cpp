@@ -0,0 +1,127 @@
+// Test del campionamento CBD_eta: i kernel bit-sliced e AVX2 devono dare gli stessi
+// coefficienti di CbdGeneric, e SampleCBDVector deve seguire la distribuzione binomiale centrata
+#include "LWE-KEM.h"
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Byte pseudocasuali riproducibili per i confronti fra i kernel
+std::vector<uint8_t> RandomBytes(size_t len, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> buf(len);
+    for (uint8_t &b : buf)
+    {
+        b = static_cast<uint8_t>(rng());
+    }
+    return buf;
+}
+
+size_t CbdBytes(size_t n, uint8_t eta)
+{
+    return (n * 2 * eta + 7) / 8;
+}
+
+using CbdKernel = void (*)(const uint8_t *, int32_t *, size_t);
+
+// Confronta kernel con CbdGeneric per lunghezze che lasciano code di ogni dimensione
+void ExpectMatchesGeneric(CbdKernel kernel, uint8_t eta, const char *name)
+{
+    for (size_t n : {1, 5, 7, 8, 15, 16, 31, 32, 33, 63, 64, 65, 77, 128, 256, 1000, 1024})
+    {
+        std::vector<uint8_t> buf = RandomBytes(CbdBytes(n, eta), static_cast<uint32_t>(n * 10 + eta));
+        std::vector<int32_t> expected(n), actual(n);
+        CbdGeneric(buf.data(), eta, expected.data(), n);
+        kernel(buf.data(), actual.data(), n);
+        EXPECT_EQ(actual, expected) << name << ", n = " << n;
+    }
+}
+
+} // namespace
+
+TEST(UTCBD, Swar_matches_generic)
+{
+    ExpectMatchesGeneric(Cbd1Swar, 1, "Cbd1Swar");
+    ExpectMatchesGeneric(Cbd2Swar, 2, "Cbd2Swar");
+    ExpectMatchesGeneric(Cbd3Swar, 3, "Cbd3Swar");
+}
+
+#ifdef LWE_KEM_X86
+TEST(UTCBD, AVX2_matches_generic)
+{
+    if (!__builtin_cpu_supports("avx2"))
+    {
+        GTEST_SKIP() << "la CPU non supporta AVX2";
+    }
+    ExpectMatchesGeneric(Cbd2AVX2, 2, "Cbd2AVX2");
+    ExpectMatchesGeneric(Cbd3AVX2, 3, "Cbd3AVX2");
+}
+#endif
+
+// SampleCBD sceglie il kernel a runtime: per ogni eta deve coincidere con quello scalare
+TEST(UTCBD, SampleCBD_matches_generic)
+{
+    for (uint8_t eta = 1; eta <= 5; ++eta)
+    {
+        const size_t n = 1024;
+        std::vector<uint8_t> buf = RandomBytes(CbdBytes(n, eta), eta);
+        std::vector<int32_t> expected(n), actual(n);
+        CbdGeneric(buf.data(), eta, expected.data(), n);
+        SampleCBD(buf.data(), eta, actual.data(), n);
+        EXPECT_EQ(actual, expected) << "eta = " << static_cast<int>(eta);
+    }
+}
+
+TEST(UTCBD, SampleCBDVector_is_deterministic)
+{
+    PrfSeed seed{};
+    for (size_t i = 0; i < seed.size(); ++i)
+    {
+        seed[i] = static_cast<uint8_t>(i);
+    }
+    std::vector<int32_t> c = SampleCBDVector(seed, 0, 256, 2);
+    EXPECT_EQ(SampleCBDVector(seed, 0, 256, 2), c);
+    EXPECT_NE(SampleCBDVector(seed, 1, 256, 2), c);
+    seed[0] ^= 1;
+    EXPECT_NE(SampleCBDVector(seed, 0, 256, 2), c);
+}
+
+// P(x) = C(2 eta, eta + x) / 4^eta per |x| <= eta; media 0 e varianza eta / 2. Con il seme fisso
+// il test e' deterministico, le tolleranze sono di 5 deviazioni standard
+TEST(UTCBD, SampleCBDVector_is_centered_binomial)
+{
+    const size_t n = 1 << 18;
+    PrfSeed seed{};
+    seed[0] = 42;
+    for (uint8_t eta = 1; eta <= 3; ++eta)
+    {
+        std::vector<int32_t> c = SampleCBDVector(seed, eta, n, eta);
+        std::vector<size_t> counts(2 * eta + 1, 0);
+        double sum = 0, sumSq = 0;
+        for (int32_t x : c)
+        {
+            ASSERT_LE(std::abs(x), eta);
+            ++counts[x + eta];
+            sum += x;
+            sumSq += static_cast<double>(x) * x;
+        }
+
+        const double variance = eta / 2.0;
+        EXPECT_NEAR(sum / n, 0.0, 5 * std::sqrt(variance / n)) << "eta = " << static_cast<int>(eta);
+        EXPECT_NEAR(sumSq / n, variance, 5 * std::sqrt(2 * variance * variance / n)) << "eta = " << static_cast<int>(eta);
+
+        double binom = 1; // C(2 eta, k)
+        for (int k = 0; k <= 2 * eta; ++k)
+        {
+            const double p = binom / std::pow(4.0, eta);
+            EXPECT_NEAR(static_cast<double>(counts[k]) / n, p, 5 * std::sqrt(p * (1 - p) / n))
+                << "eta = " << static_cast<int>(eta) << ", x = " << k - eta;
+            binom = binom * (2 * eta - k) / (k + 1);
+        }
+    }
+}
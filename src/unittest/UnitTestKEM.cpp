@@ -0,0 +1,238 @@
+// Test del formato di trasmissione del KEM (codifica compressa del ciphertext e controlli sugli
+// ingressi di Compress/Decompress e DecodeCiphertext) e di Encaps/Decaps nelle varianti LWE e Module-LWE
+#include "LWE-KEM.h"
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr uint32_t kQ = 3329;
+
+std::vector<int32_t> RandomCoefficients(size_t n, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int32_t> dist(0, kQ - 1);
+    std::vector<int32_t> u(n);
+    for (int32_t &x : u)
+    {
+        x = dist(rng);
+    }
+    return u;
+}
+
+} // namespace
+
+// Decompress(Compress(x)) dista da x al piu' round(q / 2^(d+1)) (mod q)
+TEST(UTKEM, Compress_round_trip_error)
+{
+    std::vector<int32_t> x(kQ), y(kQ);
+    for (uint32_t i = 0; i < kQ; ++i)
+    {
+        x[i] = static_cast<int32_t>(i);
+    }
+    std::vector<uint16_t> tmp(kQ);
+    for (uint32_t d = 1; d <= kUncompressedBits; ++d)
+    {
+        Compress(x.data(), kQ, kQ, d, tmp.data());
+        Decompress(tmp.data(), kQ, kQ, d, y.data());
+        const int32_t bound = static_cast<int32_t>((kQ + (1u << d)) >> (d + 1));
+        for (uint32_t i = 0; i < kQ; ++i)
+        {
+            ASSERT_LT(tmp[i], 1u << d) << "d = " << d << ", x = " << i;
+            int32_t diff = std::abs(y[i] - x[i]);
+            EXPECT_LE(std::min<int32_t>(diff, kQ - diff), bound) << "d = " << d << ", x = " << i;
+        }
+    }
+}
+
+TEST(UTKEM, Compress_rejects_invalid_bits)
+{
+    int32_t x = 1;
+    uint16_t c = 0;
+    EXPECT_THROW(Compress(&x, 1, kQ, 0, &c), std::invalid_argument);
+    EXPECT_THROW(Compress(&x, 1, kQ, 13, &c), std::invalid_argument);
+    EXPECT_THROW(Decompress(&c, 1, kQ, 0, &x), std::invalid_argument);
+    EXPECT_THROW(Decompress(&c, 1, kQ, 16, &x), std::invalid_argument);
+}
+
+TEST(UTKEM, CompressedCiphertext_round_trip)
+{
+    const size_t n = 1024;
+    for (auto d : std::vector<std::pair<uint32_t, uint32_t>>{{10, 4}, {11, 5}, {12, 12}})
+    {
+        const uint32_t du = d.first, dv = d.second;
+        std::vector<int32_t> u = RandomCoefficients(n, du), u_dec;
+        int32_t v = 1234, v_dec = 0;
+        std::vector<uint8_t> encoded(CiphertextBytes(n, du, dv));
+        EncodeCiphertext(u, v, kQ, du, dv, encoded.data());
+        DecodeCiphertext(encoded.data(), encoded.size(), n, kQ, du, dv, u_dec, v_dec);
+
+        // una seconda codifica dei valori decompressi riproduce gli stessi byte
+        std::vector<uint8_t> again(encoded.size());
+        EncodeCiphertext(u_dec, v_dec, kQ, du, dv, again.data());
+        EXPECT_EQ(again, encoded) << "du = " << du << ", dv = " << dv;
+        if (du == kUncompressedBits && dv == kUncompressedBits)
+        {
+            EXPECT_EQ(u_dec, u);
+            EXPECT_EQ(v_dec, v);
+        }
+    }
+}
+
+TEST(UTKEM, DecodeCiphertext_checks_length)
+{
+    const size_t n = 1024;
+    std::vector<int32_t> u = RandomCoefficients(n, 1), u_dec;
+    int32_t v_dec = 0;
+    std::vector<uint8_t> encoded(CiphertextBytes(n, 10, 4));
+    EncodeCiphertext(u, 7, kQ, 10, 4, encoded.data());
+    EXPECT_THROW(DecodeCiphertext(encoded.data(), encoded.size() - 1, n, kQ, 10, 4, u_dec, v_dec), std::invalid_argument);
+    EXPECT_THROW(DecodeCiphertext(encoded.data(), encoded.size() + 1, n, kQ, 10, 4, u_dec, v_dec), std::invalid_argument);
+    // la stessa lunghezza letta con altri (du, dv) non corrisponde
+    EXPECT_THROW(DecodeCiphertext(encoded.data(), encoded.size(), n, kQ, 11, 4, u_dec, v_dec), std::invalid_argument);
+    EXPECT_THROW(DecodeCiphertext(encoded.data(), encoded.size(), n, kQ, 0, 4, u_dec, v_dec), std::invalid_argument);
+    EXPECT_NO_THROW(DecodeCiphertext(encoded.data(), encoded.size(), n, kQ, 10, 4, u_dec, v_dec));
+}
+
+namespace
+{
+
+// Encaps -> codifica compressa (kCiphertextDu, kCiphertextDv) -> decodifica -> Decaps
+template <typename PublicMatrix>
+void ExpectCompressedKemAgrees()
+{
+    const uint32_t n = 512, m = 512;
+    const double stddev = 2.3;
+    const int32_t bound = 3;
+    KemPublicKey<PublicMatrix> pk;
+    KemSecretKey sk;
+    KeyGen(n, m, kQ, stddev, pk, sk, bound);
+    KemWorkspace ws(n, m, stddev);
+
+    const size_t cLen = CiphertextBytes(n, kCiphertextDu, kCiphertextDv);
+    EXPECT_EQ(cLen, PackedBytes(n, 11) + 1);
+    for (uint32_t plaintext : {0u, kQ / 2})
+    {
+        KemCiphertext c, decoded;
+        lbcrypto::SHA256Digest K, K_dec;
+        Encaps(n, m, kQ, stddev, bound, pk, c.u, c.v, plaintext, K, ws);
+
+        std::vector<uint8_t> encoded(cLen);
+        EncodeCiphertext(c.u, c.v, kQ, kCiphertextDu, kCiphertextDv, encoded.data());
+        DecodeCiphertext(encoded.data(), encoded.size(), n, kQ, kCiphertextDu, kCiphertextDv, decoded.u, decoded.v);
+        EXPECT_EQ(decoded.u, c.u) << "Encrypt deve produrre valori rappresentabili nel formato compresso";
+        EXPECT_EQ(decoded.v, c.v);
+
+        Decaps(decoded.v, decoded.u, sk, kQ, pk, n, m, stddev, bound, K_dec, ws);
+        EXPECT_EQ(K_dec, K) << "plaintext = " << plaintext;
+
+        // un bit cambiato nella codifica porta al rifiuto implicito
+        encoded[17] ^= 0x04;
+        DecodeCiphertext(encoded.data(), encoded.size(), n, kQ, kCiphertextDu, kCiphertextDv, decoded.u, decoded.v);
+        Decaps(decoded.v, decoded.u, sk, kQ, pk, n, m, stddev, bound, K_dec, ws);
+        EXPECT_NE(K_dec, K) << "plaintext = " << plaintext;
+    }
+
+    // EncapsBatch produce gli stessi ciphertext e le stesse chiavi della Encaps
+    std::vector<uint32_t> plaintexts = {0, kQ / 2, kQ / 2, 0, kQ / 2};
+    std::vector<EncapsResult> batch = EncapsBatch(n, m, kQ, stddev, bound, pk, plaintexts);
+    for (size_t l = 0; l < plaintexts.size(); ++l)
+    {
+        KemCiphertext c;
+        lbcrypto::SHA256Digest K;
+        Encaps(n, m, kQ, stddev, bound, pk, c.u, c.v, plaintexts[l], K, ws);
+        EXPECT_EQ(batch[l].c.u, c.u) << "sessione " << l;
+        EXPECT_EQ(batch[l].c.v, c.v) << "sessione " << l;
+        EXPECT_EQ(batch[l].K, K) << "sessione " << l;
+    }
+}
+
+} // namespace
+
+TEST(UTKEM, CompressedCiphertext_Decaps_MatrixInt32)
+{
+    ExpectCompressedKemAgrees<MatrixInt32>();
+}
+
+TEST(UTKEM, CompressedCiphertext_Decaps_SeededMatrix)
+{
+    ExpectCompressedKemAgrees<SeededMatrix>();
+}
+
+namespace
+{
+
+// KeyGen, codifica e decodifica delle chiavi e del ciphertext, Encaps/Decaps e rifiuto implicito
+// per la variante Module-LWE di rango k
+void ExpectMlweKemAgrees(uint32_t k)
+{
+    MlweParams params(k);
+    MlwePublicKey pk;
+    MlweSecretKey sk;
+    MlweKeyGen(params, pk, sk);
+
+    // le chiavi decodificate si ricodificano negli stessi byte e hanno lo stesso H(pk)
+    std::vector<uint8_t> pkBytes = EncodeMlwePublicKey(params, pk);
+    std::vector<uint8_t> skBytes = EncodeMlweSecretKey(params, sk);
+    ASSERT_EQ(pkBytes.size(), MlwePublicKeyBytes(params));
+    ASSERT_EQ(skBytes.size(), MlweSecretKeyBytes(params));
+    MlwePublicKey pk_dec;
+    MlweSecretKey sk_dec;
+    DecodeMlwePublicKey(params, pkBytes.data(), pkBytes.size(), pk_dec);
+    DecodeMlweSecretKey(params, skBytes.data(), skBytes.size(), sk_dec);
+    EXPECT_EQ(EncodeMlwePublicKey(params, pk_dec), pkBytes);
+    EXPECT_EQ(EncodeMlweSecretKey(params, sk_dec), skBytes);
+    EXPECT_EQ(pk_dec.hash, pk.hash);
+    EXPECT_THROW(DecodeMlwePublicKey(params, pkBytes.data(), pkBytes.size() - 1, pk_dec), std::invalid_argument);
+
+    const size_t cLen = MlweCiphertextBytes(params);
+    for (int session = 0; session < 8; ++session)
+    {
+        MlweCiphertext c, decoded;
+        lbcrypto::SHA256Digest K, K_dec;
+        MlweEncaps(params, pk_dec, c, K);
+
+        std::vector<uint8_t> encoded(cLen), again(cLen);
+        EncodeMlweCiphertext(params, c, encoded.data());
+        DecodeMlweCiphertext(params, encoded.data(), encoded.size(), decoded);
+        EncodeMlweCiphertext(params, decoded, again.data());
+        EXPECT_EQ(again, encoded) << "k = " << k << ", sessione " << session;
+        EXPECT_THROW(DecodeMlweCiphertext(params, encoded.data(), encoded.size() + 1, decoded), std::invalid_argument);
+
+        MlweDecaps(params, pk, sk_dec, decoded, K_dec);
+        EXPECT_EQ(K_dec, K) << "k = " << k << ", sessione " << session;
+
+        // un bit cambiato in u o in v: la Decaps restituisce la chiave di rifiuto H(z || H(c))
+        for (size_t pos : {size_t(session), cLen - 1 - session})
+        {
+            std::vector<uint8_t> tampered = encoded;
+            tampered[pos] ^= 0x01;
+            DecodeMlweCiphertext(params, tampered.data(), tampered.size(), decoded);
+            MlweDecaps(params, pk, sk, decoded, K_dec);
+            EXPECT_NE(K_dec, K) << "k = " << k << ", byte " << pos;
+            lbcrypto::SHA256Digest Hash_c = lbcrypto::HashUtil::SHA256Bytes(tampered.data(), tampered.size());
+            EXPECT_EQ(K_dec, HashWithCiphertext(sk.z.data(), Hash_c)) << "k = " << k << ", byte " << pos;
+        }
+    }
+}
+
+} // namespace
+
+TEST(UTKEM, Mlwe_k2)
+{
+    ExpectMlweKemAgrees(2);
+}
+
+TEST(UTKEM, Mlwe_k3)
+{
+    ExpectMlweKemAgrees(3);
+}
+
+TEST(UTKEM, Mlwe_k4)
+{
+    ExpectMlweKemAgrees(4);
+}